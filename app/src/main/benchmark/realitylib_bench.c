@@ -0,0 +1,488 @@
+/**
+ * RealityLib Bench - Scene-Scale Benchmarks for the Draw API
+ *
+ * Runs parameterized stress scenes through the real InitApp/BeginVRMode/
+ * EndVRMode path on the headless runtime and prints one JSON object per
+ * scene to stdout (logs go to stderr), so results can be diffed against a
+ * baseline run:
+ *
+ *   realitylib_bench --scene cubes:20000 --scene lines --measure 240 > new.jsonl
+ *
+ * Scenes:
+ *   cubes:N      N cubes via DrawVRCube in a lattice in front of the viewer
+ *   lines:N      N lines via DrawVRLine3D fanned around the viewer
+ *   text:K       K strings via DrawPixelText on a wall of rows
+ *   fragments:N  CubeSliceVR-style fragment storm: N falling, fading cubes
+ *   world        the main.c world (its inLoop, controllers only)
+ *   cubeslice    the CubeSliceVR.c game (its inLoop, controllers only)
+ *
+ * Timing fields use the VRFrameStats names: appMs covers the scene's
+ * draw calls, prepareMs is cull/batch/upload, eyeMs is replay per eye.
+ * Each is reported as {min, avg, p99} over the measured frames.
+ */
+
+#include "realitylib_vr.h"
+#include "realitylib_text.h"
+#include "realitylib_headless.h"
+#include <android/log.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define LOG_TAG "RealityLib_Bench"
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+#define PI 3.14159265358979323846f
+#define MAX_BENCH_SCENES 32
+
+// inLoop of main.c and CubeSliceVR.c, renamed at compile time (see CMakeLists.txt)
+void BenchWorldLoop(struct android_app* app);
+void BenchCubeSliceLoop(struct android_app* app);
+
+// =============================================================================
+// Scene Table
+// =============================================================================
+
+typedef struct {
+    const char* name;
+    int defaultCount;
+    void (*setup)(int count);
+    void (*frame)(struct android_app* app, int count, int frame);
+} BenchScene;
+
+typedef struct {
+    const BenchScene* scene;
+    int count;
+} BenchRun;
+
+static struct {
+    BenchRun runs[MAX_BENCH_SCENES];
+    int runCount;
+    int warmupFrames;
+    int measureFrames;
+    unsigned int vrFlags;
+    FILE* output;
+} bench = { .warmupFrames = 60, .measureFrames = 240 };
+
+// Deterministic hash in [0, 1) so scenes do not depend on rand() state
+static float Hash01(unsigned int n) {
+    n = (n << 13) ^ n;
+    n = n * (n * n * 15731u + 789221u) + 1376312589u;
+    return (float)(n & 0x00ffffffu) / 16777216.0f;
+}
+
+static Color HashColor(unsigned int n) {
+    return (Color){
+        (unsigned char)(64 + 191 * Hash01(n * 3 + 0)),
+        (unsigned char)(64 + 191 * Hash01(n * 3 + 1)),
+        (unsigned char)(64 + 191 * Hash01(n * 3 + 2)),
+        255
+    };
+}
+
+// =============================================================================
+// Scene: Cubes
+// =============================================================================
+
+static void FrameCubes(struct android_app* app, int count, int frame) {
+    (void)app;
+    int side = (int)ceilf(cbrtf((float)count));
+    float spacing = 0.25f;
+    float half = (side - 1) * spacing * 0.5f;
+
+    for (int i = 0; i < count; i++) {
+        int x = i % side;
+        int y = (i / side) % side;
+        int z = i / (side * side);
+        // Small per-cube bob keeps the upload path honest (nothing is static)
+        float bob = 0.02f * sinf(frame * 0.05f + i * 0.37f);
+        Vector3 pos = {
+            x * spacing - half,
+            1.6f + y * spacing - half + bob,
+            -1.5f - z * spacing
+        };
+        DrawVRCube(pos, spacing * 0.6f, HashColor((unsigned int)i));
+    }
+}
+
+// =============================================================================
+// Scene: Lines
+// =============================================================================
+
+static void FrameLines(struct android_app* app, int count, int frame) {
+    (void)app;
+    float spin = frame * 0.01f;
+    for (int i = 0; i < count; i++) {
+        float yaw = Hash01((unsigned int)i * 2) * 2.0f * PI + spin;
+        float pitch = (Hash01((unsigned int)i * 2 + 1) - 0.5f) * PI * 0.8f;
+        float length = 0.5f + 2.5f * Hash01((unsigned int)i * 7 + 3);
+        Vector3 dir = { cosf(pitch) * sinf(yaw), sinf(pitch), -cosf(pitch) * cosf(yaw) };
+        Vector3 start = { dir.x * 0.3f, 1.6f + dir.y * 0.3f, dir.z * 0.3f };
+        DrawVRLine3D(start, Vector3Add(start, Vector3Scale(dir, length)), HashColor((unsigned int)i));
+    }
+}
+
+// =============================================================================
+// Scene: Pixel Text
+// =============================================================================
+
+static void FrameText(struct android_app* app, int count, int frame) {
+    (void)app;
+    static const char* samples[] = {
+        "REALITYLIB BENCH", "SCORE 0123456789", "COMBO X12", "GAME OVER", "THE QUICK BROWN FOX"
+    };
+    int sampleCount = sizeof(samples) / sizeof(samples[0]);
+    int columns = 4;
+    float pixSize = 0.01f;
+
+    for (int i = 0; i < count; i++) {
+        int row = i / columns;
+        int col = i % columns;
+        Vector3 origin = {
+            -1.6f + col * 0.85f,
+            2.6f - (row % 40) * 0.07f,
+            -2.0f - (row / 40) * 0.5f
+        };
+        DrawPixelText(samples[(i + frame / 30) % sampleCount], origin, pixSize,
+                      HashColor((unsigned int)i), 0.0f);
+    }
+}
+
+// =============================================================================
+// Scene: Fragment Storm
+// =============================================================================
+// Mirrors CubeSliceVR's fragments: cubes thrown outward, pulled down by
+// gravity, shrinking and fading, respawned when they expire.
+
+typedef struct {
+    Vector3 position;
+    Vector3 velocity;
+    float size;
+    float lifetime;
+    Color color;
+} BenchFragment;
+
+#define FRAGMENT_LIFETIME 2.0f
+#define FRAGMENT_GRAVITY (-9.8f * 0.3f * 1.5f)
+
+static BenchFragment* fragments = NULL;
+static int fragmentCount = 0;
+static unsigned int fragmentSpawns = 0;
+
+static void SpawnFragment(BenchFragment* f) {
+    unsigned int n = fragmentSpawns++;
+    Vector3 origin = { (Hash01(n * 5) - 0.5f) * 1.5f, 1.3f + Hash01(n * 5 + 1) * 0.5f, -1.2f };
+    f->position = origin;
+    f->velocity = (Vector3){
+        (Hash01(n * 5 + 2) - 0.5f) * 4.0f,
+        0.5f + Hash01(n * 5 + 3) * 2.0f,
+        (Hash01(n * 5 + 4) - 0.5f) * 4.0f
+    };
+    f->size = 0.0175f * (0.6f + 0.4f * Hash01(n * 11));
+    // Stagger lifetimes so the storm is steady rather than pulsing
+    f->lifetime = FRAGMENT_LIFETIME * (0.25f + 0.75f * Hash01(n * 13));
+    f->color = HashColor(n);
+}
+
+static void SetupFragments(int count) {
+    free(fragments);
+    fragments = malloc(count * sizeof(BenchFragment));
+    fragmentCount = fragments ? count : 0;
+    fragmentSpawns = 0;
+    for (int i = 0; i < fragmentCount; i++) {
+        SpawnFragment(&fragments[i]);
+    }
+}
+
+static void FrameFragments(struct android_app* app, int count, int frame) {
+    (void)app;
+    (void)count;
+    (void)frame;
+    float dt = 1.0f / 72.0f;
+    for (int i = 0; i < fragmentCount; i++) {
+        BenchFragment* f = &fragments[i];
+        f->velocity.y += FRAGMENT_GRAVITY * dt;
+        f->position = Vector3Add(f->position, Vector3Scale(f->velocity, dt));
+        f->lifetime -= dt;
+        f->size *= 0.997f;
+        if (f->lifetime <= 0.0f || f->position.y < -3.0f) {
+            SpawnFragment(f);
+        }
+
+        float fade = f->lifetime / (FRAGMENT_LIFETIME * 0.3f);
+        if (fade > 1.0f) fade = 1.0f;
+        Color c = {
+            (unsigned char)(f->color.r * fade),
+            (unsigned char)(f->color.g * fade),
+            (unsigned char)(f->color.b * fade),
+            255
+        };
+        DrawVRCube(f->position, f->size, c);
+    }
+}
+
+// =============================================================================
+// Scenes: Sample Worlds
+// =============================================================================
+
+static void FrameWorld(struct android_app* app, int count, int frame) {
+    (void)count;
+    (void)frame;
+    SyncControllers();
+    BenchWorldLoop(app);
+}
+
+static void FrameCubeSlice(struct android_app* app, int count, int frame) {
+    (void)count;
+    (void)frame;
+    SyncControllers();
+    BenchCubeSliceLoop(app);
+}
+
+static const BenchScene scenes[] = {
+    { "cubes",     10000, NULL,           FrameCubes },
+    { "lines",     10000, NULL,           FrameLines },
+    { "text",        200, NULL,           FrameText },
+    { "fragments",  2000, SetupFragments, FrameFragments },
+    { "world",         0, NULL,           FrameWorld },
+    { "cubeslice",     0, NULL,           FrameCubeSlice },
+};
+static const int sceneCount = sizeof(scenes) / sizeof(scenes[0]);
+
+static const BenchScene* FindScene(const char* name, size_t length) {
+    for (int i = 0; i < sceneCount; i++) {
+        if (strlen(scenes[i].name) == length && strncmp(scenes[i].name, name, length) == 0) {
+            return &scenes[i];
+        }
+    }
+    return NULL;
+}
+
+// =============================================================================
+// Measurement
+// =============================================================================
+
+typedef struct {
+    double drawCalls;
+    double stateChanges;
+    double commandsSubmitted;
+    double commandsVisible;
+    double commandsCulled;
+    int missedFrames;
+} DrawTotals;
+
+static void RunFrame(struct android_app* app, const BenchRun* run, int frame) {
+    BeginVRMode();
+    run->scene->frame(app, run->count, frame);
+    EndVRMode();
+}
+
+static void WriteTiming(const char* name, float minMs, float avgMs, float p99Ms) {
+    fprintf(bench.output, "\"%s\":{\"min\":%.4f,\"avg\":%.4f,\"p99\":%.4f},", name, minMs, avgMs, p99Ms);
+}
+
+static void WriteResult(const BenchRun* run, int frames, const DrawTotals* totals) {
+    VRFrameStats lo = GetVRFrameStatsMin();
+    VRFrameStats avg = GetVRFrameStatsAvg();
+    VRFrameStats p99 = GetVRFrameStatsP99();
+    HeadlessConfig config = GetHeadlessConfig();
+
+    fprintf(bench.output, "{\"scene\":\"%s\",\"count\":%d,\"frames\":%d,\"eyeWidth\":%d,\"eyeHeight\":%d,"
+            "\"multiview\":%s,\"threaded\":%s,\"msaa\":%d,",
+            run->scene->name, run->count, frames, config.eyeWidth, config.eyeHeight,
+            IsVRMultiviewEnabled() ? "true" : "false", IsVRRenderThreadEnabled() ? "true" : "false",
+            GetVRMSAASamples());
+    WriteTiming("appMs", lo.appMs, avg.appMs, p99.appMs);
+    WriteTiming("prepareMs", lo.prepareMs, avg.prepareMs, p99.prepareMs);
+    WriteTiming("eye0Ms", lo.eyeMs[0], avg.eyeMs[0], p99.eyeMs[0]);
+    WriteTiming("eye1Ms", lo.eyeMs[1], avg.eyeMs[1], p99.eyeMs[1]);
+    WriteTiming("gpuMs", lo.gpuMs, avg.gpuMs, p99.gpuMs);
+    WriteTiming("frameMs", lo.frameMs, avg.frameMs, p99.frameMs);
+    WriteTiming("resolutionScale", lo.resolutionScale, avg.resolutionScale, p99.resolutionScale);
+    fprintf(bench.output, "\"drawCalls\":%.1f,\"stateChanges\":%.1f,\"commandsSubmitted\":%.1f,"
+            "\"commandsVisible\":%.1f,\"commandsCulled\":%.1f,\"missedFrames\":%d}\n",
+            totals->drawCalls / frames, totals->stateChanges / frames, totals->commandsSubmitted / frames,
+            totals->commandsVisible / frames, totals->commandsCulled / frames, totals->missedFrames);
+    fflush(bench.output);
+}
+
+static bool RunScene(struct android_app* app, const BenchRun* run) {
+    LOGI("Scene %s (count %d): %d warm-up + %d measured frames",
+         run->scene->name, run->count, bench.warmupFrames, bench.measureFrames);
+
+    // Every scene starts from the same player pose; the sample worlds move it
+    SetPlayerPosition((Vector3){ 0, 0, 0 });
+    SetPlayerYaw(0.0f);
+    if (run->scene->setup) run->scene->setup(run->count);
+
+    int frame = 0;
+    for (int i = 0; i < bench.warmupFrames; i++, frame++) {
+        if (AppShouldClose(app)) return false;
+        RunFrame(app, run, frame);
+    }
+
+    ResetVRFrameStats();
+    DrawTotals totals = {0};
+    int missedBefore = GetMissedFrameCount();
+    for (int i = 0; i < bench.measureFrames; i++, frame++) {
+        if (AppShouldClose(app)) return false;
+        RunFrame(app, run, frame);
+
+        VRDrawStats draw = GetVRDrawStats();
+        totals.drawCalls += draw.drawCalls;
+        totals.stateChanges += draw.stateChanges;
+        totals.commandsSubmitted += draw.commandsSubmitted;
+        totals.commandsVisible += draw.commandsVisible;
+        totals.commandsCulled += draw.commandsCulled;
+    }
+    totals.missedFrames = GetMissedFrameCount() - missedBefore;
+
+    WriteResult(run, bench.measureFrames, &totals);
+    return true;
+}
+
+void android_main(struct android_app* app) {
+    SetVRConfigFlags(bench.vrFlags);
+    if (!InitApp(app)) {
+        LOGE("Failed to initialize VR");
+        return;
+    }
+
+    // Unfocused frames are throttled, so wait for the runtime to grant focus
+    while (!AppShouldClose(app) && !IsVRSessionFocused()) {
+        BeginVRMode();
+        EndVRMode();
+    }
+
+    for (int i = 0; i < bench.runCount; i++) {
+        if (!RunScene(app, &bench.runs[i])) {
+            LOGE("Session ended during scene %s", bench.runs[i].scene->name);
+            break;
+        }
+    }
+
+    free(fragments);
+    fragments = NULL;
+    CloseApp(app);
+}
+
+// =============================================================================
+// Entry Point
+// =============================================================================
+
+static void PrintUsage(const char* program) {
+    fprintf(stderr, "Usage: %s [options]\n", program);
+    fprintf(stderr,
+        "  --scene NAME[:N] run a scene (repeatable; default: all scenes)\n"
+        "                   cubes, lines, text, fragments, world, cubeslice\n"
+        "  --warmup F       unmeasured frames before each scene (default 60)\n"
+        "  --measure F      measured frames per scene (default 240, max 256)\n"
+        "  --no-multiview   force two-pass stereo\n"
+        "  --threaded       render on a separate thread (FLAG_VR_THREADED_RENDER)\n"
+        "  --depth16        16-bit depth buffer (FLAG_VR_DEPTH_16)\n"
+        "  --msaa N         MSAA samples: 1, 2 or 4 (FLAG_VR_MSAA_2X / FLAG_VR_MSAA_4X)\n"
+        "  --dynamic-res    scale resolution from GPU time (FLAG_VR_DYNAMIC_RESOLUTION)\n"
+        "  --output FILE    write results to FILE instead of stdout\n");
+    PrintHeadlessOptions();
+}
+
+static bool AddRun(const char* spec) {
+    const char* colon = strchr(spec, ':');
+    size_t nameLength = colon ? (size_t)(colon - spec) : strlen(spec);
+    const BenchScene* scene = FindScene(spec, nameLength);
+    if (!scene || bench.runCount >= MAX_BENCH_SCENES) return false;
+
+    int count = colon ? atoi(colon + 1) : scene->defaultCount;
+    if (count < 0) return false;
+    bench.runs[bench.runCount++] = (BenchRun){ scene, count };
+    return true;
+}
+
+int main(int argc, char** argv) {
+    HeadlessConfig config = GetHeadlessDefaultConfig();
+    const char* outputPath = NULL;
+    bench.output = stdout;
+
+    for (int i = 1; i < argc; ) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+
+        if (strcmp(arg, "--scene") == 0 && value) {
+            if (!AddRun(value)) {
+                fprintf(stderr, "Unknown scene: %s\n", value);
+                return 1;
+            }
+            i += 2;
+        } else if (strcmp(arg, "--warmup") == 0 && value) {
+            bench.warmupFrames = atoi(value);
+            i += 2;
+        } else if (strcmp(arg, "--measure") == 0 && value) {
+            bench.measureFrames = atoi(value);
+            i += 2;
+        } else if (strcmp(arg, "--no-multiview") == 0) {
+            bench.vrFlags |= FLAG_VR_NO_MULTIVIEW;
+            i += 1;
+        } else if (strcmp(arg, "--threaded") == 0) {
+            bench.vrFlags |= FLAG_VR_THREADED_RENDER;
+            i += 1;
+        } else if (strcmp(arg, "--depth16") == 0) {
+            bench.vrFlags |= FLAG_VR_DEPTH_16;
+            i += 1;
+        } else if (strcmp(arg, "--dynamic-res") == 0) {
+            bench.vrFlags |= FLAG_VR_DYNAMIC_RESOLUTION;
+            i += 1;
+        } else if (strcmp(arg, "--msaa") == 0 && value) {
+            int samples = atoi(value);
+            if (samples != 1 && samples != 2 && samples != 4) {
+                fprintf(stderr, "Unsupported MSAA level: %s\n", value);
+                return 1;
+            }
+            bench.vrFlags &= ~(FLAG_VR_MSAA_2X | FLAG_VR_MSAA_4X);
+            if (samples == 2) bench.vrFlags |= FLAG_VR_MSAA_2X;
+            if (samples == 4) bench.vrFlags |= FLAG_VR_MSAA_4X;
+            i += 2;
+        } else if (strcmp(arg, "--output") == 0 && value) {
+            outputPath = value;
+            i += 2;
+        } else {
+            int consumed = ParseHeadlessOption(argc, argv, i, &config);
+            if (consumed == 0) {
+                PrintUsage(argv[0]);
+                return strcmp(arg, "--help") == 0 ? 0 : 1;
+            }
+            i += consumed;
+        }
+    }
+
+    if (bench.measureFrames <= 0) bench.measureFrames = 1;
+    if (bench.measureFrames > VR_FRAME_STATS_HISTORY) {
+        // Timings come from the frame stats history; keep every field on one window
+        fprintf(stderr, "--measure %d exceeds the %d-frame timing history, using %d\n",
+                bench.measureFrames, VR_FRAME_STATS_HISTORY, VR_FRAME_STATS_HISTORY);
+        bench.measureFrames = VR_FRAME_STATS_HISTORY;
+    }
+    if (bench.warmupFrames < 0) bench.warmupFrames = 0;
+    if (bench.runCount == 0) {
+        for (int i = 0; i < sceneCount; i++) {
+            bench.runs[bench.runCount++] = (BenchRun){ &scenes[i], scenes[i].defaultCount };
+        }
+    }
+
+    if (outputPath) {
+        bench.output = fopen(outputPath, "w");
+        if (!bench.output) {
+            perror(outputPath);
+            return 1;
+        }
+    }
+
+    // The scenes decide when to stop; a frame limit would end the session early
+    config.frameLimit = 0;
+    SetHeadlessConfig(config);
+    RunHeadlessApp();
+
+    if (bench.output != stdout) fclose(bench.output);
+    return 0;
+}
@@ -461,11 +461,11 @@ static void DrawBlade(int hand, VRController ctrl) {
 
     Color col = GetBladeColor(hand);
 
-    // Handle
+    // Handle and blade follow the controller's late-latched pose
+    BeginVRDrawSpace(hand == 0 ? VR_SPACE_LEFT_CONTROLLER : VR_SPACE_RIGHT_CONTROLLER);
     DrawVRSphere(ctrl.position, 0.02f, GRAY);
-
-    // Blade line
     DrawVRLine3D(ctrl.position, bladeEnd, col);
+    EndVRDrawSpace();
 
     // Trail
     BladeState* b = &game.blades[hand];
@@ -915,11 +915,9 @@ void inLoop(struct android_app* app) {
         InitGame();
     }
 
-    // Delta time from display refresh rate
+    // Delta time between displayed frames (tracks 72/90/120 Hz and drops)
     VRHeadset headset = GetHeadset();
-    game.deltaTime = (headset.displayRefreshRate > 0)
-                   ? 1.0f / headset.displayRefreshRate
-                   : 1.0f / 72.0f;
+    game.deltaTime = GetFrameTime();
     game.gameTime += game.deltaTime;
 
     // Deferred capture of player center: wait until headset reports a valid
@@ -1033,8 +1031,10 @@ void android_main(struct android_app* app) {
     // Main loop
     while (!AppShouldClose(app)) {
         BeginVRMode();
-        SyncControllers();
-        inLoop(app);
+        if (ShouldUpdateThisFrame()) {
+            SyncControllers();
+            inLoop(app);
+        }
         EndVRMode();
     }
 
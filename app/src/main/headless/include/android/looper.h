@@ -0,0 +1,23 @@
+/**
+ * Headless shim for <android/looper.h>
+ *
+ * There is no activity on a headless box, so polling only ever times out.
+ */
+
+#ifndef REALITYLIB_HEADLESS_ANDROID_LOOPER_H
+#define REALITYLIB_HEADLESS_ANDROID_LOOPER_H
+
+typedef struct ALooper ALooper;
+
+enum {
+    ALOOPER_POLL_WAKE = -1,
+    ALOOPER_POLL_CALLBACK = -2,
+    ALOOPER_POLL_TIMEOUT = -3,
+    ALOOPER_POLL_ERROR = -4
+};
+
+ALooper* ALooper_forThread(void);
+void ALooper_wake(ALooper* looper);
+int ALooper_pollOnce(int timeoutMillis, int* outFd, int* outEvents, void** outData);
+
+#endif // REALITYLIB_HEADLESS_ANDROID_LOOPER_H
@@ -0,0 +1,13 @@
+/**
+ * Headless shim for <android/native_window.h>
+ *
+ * Only the opaque types referenced by the OpenXR platform header.
+ */
+
+#ifndef REALITYLIB_HEADLESS_ANDROID_NATIVE_WINDOW_H
+#define REALITYLIB_HEADLESS_ANDROID_NATIVE_WINDOW_H
+
+typedef struct ANativeWindow ANativeWindow;
+typedef struct AHardwareBuffer AHardwareBuffer;
+
+#endif // REALITYLIB_HEADLESS_ANDROID_NATIVE_WINDOW_H
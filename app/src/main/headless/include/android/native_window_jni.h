@@ -0,0 +1,11 @@
+/**
+ * Headless shim for <android/native_window_jni.h>
+ */
+
+#ifndef REALITYLIB_HEADLESS_ANDROID_NATIVE_WINDOW_JNI_H
+#define REALITYLIB_HEADLESS_ANDROID_NATIVE_WINDOW_JNI_H
+
+#include <android/native_window.h>
+#include <jni.h>
+
+#endif // REALITYLIB_HEADLESS_ANDROID_NATIVE_WINDOW_JNI_H
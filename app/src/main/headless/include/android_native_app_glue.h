@@ -0,0 +1,43 @@
+/**
+ * Headless shim for android_native_app_glue.h
+ *
+ * Mirrors the fields of struct android_app that RealityLib and the samples
+ * touch. realitylib_headless.c fills one in and hands it to android_main().
+ */
+
+#ifndef REALITYLIB_HEADLESS_ANDROID_NATIVE_APP_GLUE_H
+#define REALITYLIB_HEADLESS_ANDROID_NATIVE_APP_GLUE_H
+
+#include <android/looper.h>
+#include <android/native_window.h>
+#include <jni.h>
+
+typedef struct ANativeActivity {
+    JavaVM* vm;
+    JNIEnv* env;
+    jobject clazz;
+    const char* internalDataPath;
+    const char* externalDataPath;
+} ANativeActivity;
+
+struct android_app;
+
+struct android_poll_source {
+    int id;
+    struct android_app* app;
+    void (*process)(struct android_app* app, struct android_poll_source* source);
+};
+
+struct android_app {
+    void* userData;
+    void (*onAppCmd)(struct android_app* app, int cmd);
+    ANativeActivity* activity;
+    ALooper* looper;
+    ANativeWindow* window;
+    int activityState;
+    int destroyRequested;
+};
+
+void android_main(struct android_app* app);
+
+#endif // REALITYLIB_HEADLESS_ANDROID_NATIVE_APP_GLUE_H
@@ -0,0 +1,15 @@
+/**
+ * Headless shim for <jni.h>
+ *
+ * The OpenXR Android structs carry the VM and activity as opaque pointers;
+ * the simulated runtime never dereferences them.
+ */
+
+#ifndef REALITYLIB_HEADLESS_JNI_H
+#define REALITYLIB_HEADLESS_JNI_H
+
+typedef void* jobject;
+typedef struct _JNIEnv JNIEnv;
+typedef struct _JavaVM JavaVM;
+
+#endif // REALITYLIB_HEADLESS_JNI_H
@@ -0,0 +1,1271 @@
+/**
+ * RealityLib Headless - Simulated OpenXR Runtime for Linux
+ *
+ * Implements the OpenXR entry points RealityLib calls, the handful of
+ * Android NDK functions it links against, and the helpers entry points use
+ * to drive android_main() the way NativeActivity would.
+ * See realitylib_headless.h.
+ */
+
+#include "realitylib_headless.h"
+#include "realitylib_capture.h"
+#include <android/log.h>
+#include <android/looper.h>
+#include <android_native_app_glue.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GLES3/gl3.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include <jni.h>
+
+// XR_USE_GRAPHICS_API_OPENGL_ES and XR_USE_PLATFORM_ANDROID are defined in CMakeLists.txt
+#include <openxr/openxr.h>
+#include <openxr/openxr_platform.h>
+
+#define LOG_TAG "RealityLib_Headless"
+#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+
+#define SIM_PI 3.14159265358979f
+
+#define SIM_SWAPCHAIN_IMAGES 3
+#define SIM_MAX_SPACES 32
+#define SIM_MAX_ACTIONS 32
+#define SIM_MAX_PATHS 128
+#define SIM_MAX_EVENTS 16
+
+// Finite-difference step for space and joint velocities
+#define SIM_VELOCITY_DT_NS 5000000
+
+// =============================================================================
+// Runtime State
+// =============================================================================
+
+typedef enum {
+    SIM_SPACE_REFERENCE,
+    SIM_SPACE_ACTION
+} SimSpaceKind;
+
+typedef struct {
+    bool used;
+    SimSpaceKind kind;
+    XrReferenceSpaceType referenceType;
+    int hand;                           // Action spaces: 0 = left, 1 = right
+    XrPosef offset;                     // poseInReferenceSpace / poseInActionSpace
+} SimSpace;
+
+typedef struct {
+    char name[XR_MAX_ACTION_NAME_SIZE];
+    XrActionType type;
+    float value[2][2];                  // [hand][x/y] at the last xrSyncActions
+    float previous[2][2];
+} SimAction;
+
+typedef struct {
+    GLuint images[SIM_SWAPCHAIN_IMAGES];
+    GLenum target;
+    uint32_t nextImage;
+} SimSwapchain;
+
+typedef struct {
+    HeadlessConfig config;
+    bool configured;
+
+    XrTime epoch;                       // XrTime of frame zero
+    XrDuration period;                  // Display period in ns
+    XrTime lastDisplayTime;             // Predicted time handed out by xrWaitFrame
+    XrTime nextWakeTime;                // Throttled mode: when xrWaitFrame may return
+    uint64_t framesWaited;
+    uint64_t framesEnded;
+
+    XrSessionState sessionState;
+    bool exitRequested;
+    XrSessionState events[SIM_MAX_EVENTS];
+    int eventHead;
+    int eventCount;
+
+    SimSpace spaces[SIM_MAX_SPACES];
+    SimAction actions[SIM_MAX_ACTIONS];
+    int actionCount;
+    char paths[SIM_MAX_PATHS][XR_MAX_PATH_LENGTH];
+    int pathCount;
+} SimRuntime;
+
+static SimRuntime sim = {0};
+
+// xrEndFrame can run on RealityLib's render thread while the app polls events
+static pthread_mutex_t simEventLock = PTHREAD_MUTEX_INITIALIZER;
+
+HeadlessConfig GetHeadlessDefaultConfig(void) {
+    return (HeadlessConfig){
+        .eyeWidth = 1440,
+        .eyeHeight = 1584,
+        .refreshRate = 72.0f,
+        .throttle = false,
+        .frameLimit = 0,
+        .handTracking = true,
+        .scriptedInput = true
+    };
+}
+
+void SetHeadlessConfig(HeadlessConfig config) {
+    sim.config = config;
+    sim.configured = true;
+}
+
+HeadlessConfig GetHeadlessConfig(void) {
+    if (!sim.configured) SetHeadlessConfig(GetHeadlessDefaultConfig());
+    return sim.config;
+}
+
+uint64_t GetHeadlessFrameCount(void) {
+    return sim.framesEnded;
+}
+
+static double ScriptSeconds(XrTime time) {
+    return (double)(time - sim.epoch) * 1e-9;
+}
+
+double GetHeadlessScriptTime(void) {
+    return ScriptSeconds(sim.lastDisplayTime);
+}
+
+static XrTime NowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (XrTime)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static void SleepUntilNs(XrTime target) {
+    XrTime remaining = target - NowNs();
+    if (remaining <= 0) return;
+    struct timespec ts = { (time_t)(remaining / 1000000000LL), (long)(remaining % 1000000000LL) };
+    nanosleep(&ts, NULL);
+}
+
+// =============================================================================
+// Android Shims
+// =============================================================================
+
+int __android_log_print(int prio, const char* tag, const char* fmt, ...) {
+    static int minPriority = -1;
+    if (minPriority < 0) {
+        const char* verbose = getenv("REALITYLIB_VERBOSE");
+        minPriority = (verbose && verbose[0] == '1') ? ANDROID_LOG_VERBOSE : ANDROID_LOG_INFO;
+    }
+    if (prio < minPriority) return 0;
+
+    static const char levels[] = "??VDIWEFS";
+    char level = (prio >= 0 && prio < (int)sizeof(levels) - 1) ? levels[prio] : '?';
+
+    va_list args;
+    va_start(args, fmt);
+    fprintf(stderr, "%c/%s: ", level, tag);
+    int written = vfprintf(stderr, fmt, args);
+    fputc('\n', stderr);
+    va_end(args);
+    return written;
+}
+
+ALooper* ALooper_forThread(void) {
+    return NULL;
+}
+
+void ALooper_wake(ALooper* looper) {
+    (void)looper;
+}
+
+int ALooper_pollOnce(int timeoutMillis, int* outFd, int* outEvents, void** outData) {
+    (void)outFd;
+    (void)outEvents;
+    if (outData) *outData = NULL;
+    if (timeoutMillis > 0) {
+        SleepUntilNs(NowNs() + (XrTime)timeoutMillis * 1000000LL);
+    }
+    return ALOOPER_POLL_TIMEOUT;
+}
+
+// =============================================================================
+// Pose Math
+// =============================================================================
+
+static XrQuaternionf QuatMultiply(XrQuaternionf a, XrQuaternionf b) {
+    return (XrQuaternionf){
+        a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+        a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+        a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+        a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z
+    };
+}
+
+static XrQuaternionf QuatConjugate(XrQuaternionf q) {
+    return (XrQuaternionf){ -q.x, -q.y, -q.z, q.w };
+}
+
+static XrQuaternionf QuatFromYawPitchRoll(float yaw, float pitch, float roll) {
+    XrQuaternionf qy = { 0, sinf(yaw * 0.5f), 0, cosf(yaw * 0.5f) };
+    XrQuaternionf qx = { sinf(pitch * 0.5f), 0, 0, cosf(pitch * 0.5f) };
+    XrQuaternionf qz = { 0, 0, sinf(roll * 0.5f), cosf(roll * 0.5f) };
+    return QuatMultiply(QuatMultiply(qy, qx), qz);
+}
+
+static XrVector3f QuatRotate(XrQuaternionf q, XrVector3f v) {
+    // v' = v + 2w(u x v) + 2u x (u x v)
+    XrVector3f u = { q.x, q.y, q.z };
+    XrVector3f t = {
+        2.0f * (u.y * v.z - u.z * v.y),
+        2.0f * (u.z * v.x - u.x * v.z),
+        2.0f * (u.x * v.y - u.y * v.x)
+    };
+    return (XrVector3f){
+        v.x + q.w * t.x + (u.y * t.z - u.z * t.y),
+        v.y + q.w * t.y + (u.z * t.x - u.x * t.z),
+        v.z + q.w * t.z + (u.x * t.y - u.y * t.x)
+    };
+}
+
+static XrVector3f VecAdd(XrVector3f a, XrVector3f b) {
+    return (XrVector3f){ a.x + b.x, a.y + b.y, a.z + b.z };
+}
+
+static XrVector3f VecSub(XrVector3f a, XrVector3f b) {
+    return (XrVector3f){ a.x - b.x, a.y - b.y, a.z - b.z };
+}
+
+static XrVector3f VecScale(XrVector3f v, float s) {
+    return (XrVector3f){ v.x * s, v.y * s, v.z * s };
+}
+
+static XrVector3f VecLerp(XrVector3f a, XrVector3f b, float t) {
+    return VecAdd(a, VecScale(VecSub(b, a), t));
+}
+
+static XrPosef PoseCompose(XrPosef parent, XrPosef child) {
+    return (XrPosef){
+        .orientation = QuatMultiply(parent.orientation, child.orientation),
+        .position = VecAdd(parent.position, QuatRotate(parent.orientation, child.position))
+    };
+}
+
+static XrPosef PoseInverse(XrPosef pose) {
+    XrQuaternionf inv = QuatConjugate(pose.orientation);
+    return (XrPosef){
+        .orientation = inv,
+        .position = VecScale(QuatRotate(inv, pose.position), -1.0f)
+    };
+}
+
+// Angular velocity that takes a to b over dt seconds (small-angle)
+static XrVector3f AngularVelocity(XrQuaternionf a, XrQuaternionf b, float dt) {
+    XrQuaternionf delta = QuatMultiply(b, QuatConjugate(a));
+    float sign = delta.w < 0.0f ? -1.0f : 1.0f;
+    return (XrVector3f){ 2.0f * sign * delta.x / dt, 2.0f * sign * delta.y / dt, 2.0f * sign * delta.z / dt };
+}
+
+// =============================================================================
+// Input Script
+// =============================================================================
+// Everything below is a pure function of script time so runs are repeatable.
+
+static XrPosef ScriptHeadPose(double t) {
+    if (!sim.config.scriptedInput) {
+        return (XrPosef){ {0, 0, 0, 1}, {0, 1.6f, 0} };
+    }
+    float ft = (float)t;
+    return (XrPosef){
+        .orientation = QuatFromYawPitchRoll(0.25f * sinf(0.3f * ft), 0.1f * sinf(0.4f * ft), 0.0f),
+        .position = { 0.05f * sinf(0.5f * ft), 1.6f + 0.01f * sinf(2.0f * ft), 0.0f }
+    };
+}
+
+static XrPosef ScriptControllerPose(int hand, double t) {
+    float side = hand == 0 ? -1.0f : 1.0f;
+    XrPosef pose = { {0, 0, 0, 1}, { 0.2f * side, 1.2f, -0.35f } };
+    if (!sim.config.scriptedInput) return pose;
+
+    float ft = (float)t;
+    float phase = hand == 0 ? SIM_PI : 0.0f;
+    pose.position.x += 0.10f * sinf(1.3f * ft + phase);
+    pose.position.y += 0.08f * sinf(2.1f * ft + phase);
+    pose.position.z += 0.10f * sinf(0.9f * ft + phase);
+    pose.orientation = QuatFromYawPitchRoll(0.3f * sinf(0.7f * ft + phase),
+                                            -0.3f + 0.2f * sinf(ft + phase),
+                                            0.2f * side * sinf(1.1f * ft));
+    return pose;
+}
+
+// Square pulse: 1 for `width` seconds out of every `period`
+static float ScriptPulse(double t, double period, double width, double offset) {
+    double phase = fmod(t + offset, period);
+    return phase < width ? 1.0f : 0.0f;
+}
+
+static void ScriptActionValue(const char* name, int hand, double t, float* x, float* y) {
+    *x = 0.0f;
+    *y = 0.0f;
+    if (!sim.config.scriptedInput) return;
+
+    double offset = hand == 0 ? 1.0 : 0.0;
+    if (strcmp(name, "trigger") == 0) {
+        *x = 0.5f - 0.5f * cosf(2.0f * SIM_PI * (float)((t + offset) / 2.0));
+    } else if (strcmp(name, "grip") == 0) {
+        *x = ScriptPulse(t, 3.0, 0.5, offset * 1.5);
+    } else if (strcmp(name, "thumbstick") == 0) {
+        if (hand == 0) {
+            float a = 2.0f * SIM_PI * (float)(t / 8.0);
+            *x = 0.3f * sinf(a);
+            *y = 0.3f * cosf(a);
+        } else {
+            *x = 0.9f * ScriptPulse(t, 5.0, 0.2, 2.5);
+        }
+    } else if (strcmp(name, "button_a") == 0) {
+        *x = ScriptPulse(t, 2.0, 0.1, offset);
+    } else if (strcmp(name, "button_b") == 0) {
+        *x = ScriptPulse(t, 3.3, 0.1, offset);
+    }
+    // thumbstick_click and menu stay released: they pause or quit the samples
+}
+
+// =============================================================================
+// Scripted Hand Skeleton
+// =============================================================================
+// Hand-local frame: fingers extend along -Z, palm faces -Y, thumb on the
+// inside (-X for the right hand, mirrored for the left).
+
+static float ScriptPinch(int hand, double t) {
+    if (!sim.config.scriptedInput) return 0.0f;
+    double offset = hand == 0 ? 1.5 : 0.0;
+    float phase = (float)fmod((t + offset) / 3.0, 1.0);
+    // Close over 0.4 of the cycle, hold, then open
+    if (phase < 0.4f) return 0.5f - 0.5f * cosf(SIM_PI * phase / 0.4f);
+    if (phase < 0.6f) return 1.0f;
+    if (phase < 0.8f) return 0.5f + 0.5f * cosf(SIM_PI * (phase - 0.6f) / 0.2f);
+    return 0.0f;
+}
+
+static void BuildFinger(XrVector3f* joints, XrVector3f knuckle, const float* lengths, int segments, float curl) {
+    static const float bend[3] = { 1.2f, 1.6f, 1.0f };   // Radians at full curl
+    XrVector3f p = knuckle;
+    float angle = 0.0f;
+    joints[0] = p;
+    for (int s = 0; s < segments; s++) {
+        angle += curl * bend[s];
+        p = VecAdd(p, (XrVector3f){ 0.0f, -sinf(angle) * lengths[s], -cosf(angle) * lengths[s] });
+        joints[s + 1] = p;
+    }
+}
+
+static void ScriptHandJoints(int hand, double t, XrPosef* joints, float* radii) {
+    static const float fingerX[4] = { -0.025f, -0.008f, 0.010f, 0.027f };
+    static const float knuckleZ[4] = { -0.090f, -0.095f, -0.090f, -0.080f };
+    static const float fingerLengths[4][3] = {
+        { 0.045f, 0.027f, 0.022f },
+        { 0.050f, 0.031f, 0.024f },
+        { 0.047f, 0.029f, 0.023f },
+        { 0.037f, 0.021f, 0.020f }
+    };
+
+    float mirror = hand == 0 ? -1.0f : 1.0f;
+    float pinch = ScriptPinch(hand, t);
+    XrVector3f local[XR_HAND_JOINT_COUNT_EXT];
+
+    local[XR_HAND_JOINT_WRIST_EXT] = (XrVector3f){ 0, 0, 0 };
+
+    // Index..little: metacarpal base at the wrist, then knuckle..tip
+    for (int f = 0; f < 4; f++) {
+        int base = XR_HAND_JOINT_INDEX_METACARPAL_EXT + f * 5;
+        float curl = f == 0 ? 0.35f * pinch : 0.15f;
+        local[base] = (XrVector3f){ fingerX[f] * 0.5f, 0.0f, -0.01f };
+        BuildFinger(&local[base + 1], (XrVector3f){ fingerX[f], 0.0f, knuckleZ[f] },
+                    fingerLengths[f], 3, curl);
+    }
+
+    // Thumb: splayed forward and inward, tip drawn onto the index tip by the pinch
+    static const float thumbLengths[3] = { 0.040f, 0.032f, 0.028f };
+    XrVector3f thumb[4];
+    XrVector3f thumbBase = { -0.020f, -0.010f, -0.025f };
+    XrVector3f thumbDir = { -0.55f, -0.15f, -0.82f };
+    thumb[0] = thumbBase;
+    for (int s = 0; s < 3; s++) {
+        thumb[s + 1] = VecAdd(thumb[s], VecScale(thumbDir, thumbLengths[s]));
+    }
+    XrVector3f indexTip = local[XR_HAND_JOINT_INDEX_TIP_EXT];
+    thumb[2] = VecLerp(thumb[2], VecAdd(indexTip, (XrVector3f){ -0.015f, -0.010f, 0.015f }), pinch);
+    thumb[3] = VecLerp(thumb[3], VecAdd(indexTip, (XrVector3f){ -0.004f, -0.006f, 0.002f }), pinch);
+    for (int s = 0; s < 4; s++) {
+        local[XR_HAND_JOINT_THUMB_METACARPAL_EXT + s] = thumb[s];
+    }
+
+    local[XR_HAND_JOINT_PALM_EXT] = VecScale(local[XR_HAND_JOINT_MIDDLE_PROXIMAL_EXT], 0.5f);
+
+    XrPosef wrist = ScriptControllerPose(hand, t);
+    for (int j = 0; j < XR_HAND_JOINT_COUNT_EXT; j++) {
+        XrVector3f p = local[j];
+        p.x *= mirror;
+        joints[j].orientation = wrist.orientation;
+        joints[j].position = VecAdd(wrist.position, QuatRotate(wrist.orientation, p));
+
+        bool tip = j == XR_HAND_JOINT_THUMB_TIP_EXT || j == XR_HAND_JOINT_INDEX_TIP_EXT ||
+                   j == XR_HAND_JOINT_MIDDLE_TIP_EXT || j == XR_HAND_JOINT_RING_TIP_EXT ||
+                   j == XR_HAND_JOINT_LITTLE_TIP_EXT;
+        radii[j] = j <= XR_HAND_JOINT_WRIST_EXT ? 0.02f : (tip ? 0.008f : 0.01f);
+    }
+}
+
+// =============================================================================
+// Session State Events
+// =============================================================================
+
+static void QueueSessionState(XrSessionState state) {
+    pthread_mutex_lock(&simEventLock);
+    if (sim.eventCount >= SIM_MAX_EVENTS) {
+        LOGE("Session event queue full, dropping state %d", state);
+    } else {
+        sim.events[(sim.eventHead + sim.eventCount) % SIM_MAX_EVENTS] = state;
+        sim.eventCount++;
+    }
+    pthread_mutex_unlock(&simEventLock);
+}
+
+static void RequestSessionExit(void) {
+    pthread_mutex_lock(&simEventLock);
+    bool alreadyRequested = sim.exitRequested;
+    sim.exitRequested = true;
+    pthread_mutex_unlock(&simEventLock);
+    if (alreadyRequested) return;
+
+    QueueSessionState(XR_SESSION_STATE_VISIBLE);
+    QueueSessionState(XR_SESSION_STATE_SYNCHRONIZED);
+    QueueSessionState(XR_SESSION_STATE_STOPPING);
+}
+
+XrResult xrPollEvent(XrInstance instance, XrEventDataBuffer* eventData) {
+    (void)instance;
+    pthread_mutex_lock(&simEventLock);
+    if (sim.eventCount == 0) {
+        pthread_mutex_unlock(&simEventLock);
+        return XR_EVENT_UNAVAILABLE;
+    }
+
+    XrSessionState state = sim.events[sim.eventHead];
+    sim.eventHead = (sim.eventHead + 1) % SIM_MAX_EVENTS;
+    sim.eventCount--;
+    pthread_mutex_unlock(&simEventLock);
+    sim.sessionState = state;
+
+    XrEventDataSessionStateChanged* changed = (XrEventDataSessionStateChanged*)eventData;
+    changed->type = XR_TYPE_EVENT_DATA_SESSION_STATE_CHANGED;
+    changed->next = NULL;
+    changed->session = (XrSession)(uintptr_t)1;
+    changed->state = state;
+    changed->time = sim.lastDisplayTime;
+    return XR_SUCCESS;
+}
+
+// =============================================================================
+// Instance and System
+// =============================================================================
+
+static const char* SupportedExtensions(uint32_t index) {
+    static const char* names[] = {
+        XR_KHR_OPENGL_ES_ENABLE_EXTENSION_NAME,
+        XR_KHR_ANDROID_CREATE_INSTANCE_EXTENSION_NAME,
+        XR_EXT_HAND_TRACKING_EXTENSION_NAME
+    };
+    uint32_t count = GetHeadlessConfig().handTracking ? 3 : 2;
+    return index < count ? names[index] : NULL;
+}
+
+XrResult xrEnumerateInstanceExtensionProperties(const char* layerName, uint32_t propertyCapacityInput,
+                                                uint32_t* propertyCountOutput, XrExtensionProperties* properties) {
+    (void)layerName;
+    uint32_t count = 0;
+    while (SupportedExtensions(count)) count++;
+    *propertyCountOutput = count;
+    if (propertyCapacityInput == 0) return XR_SUCCESS;
+    if (propertyCapacityInput < count) return XR_ERROR_SIZE_INSUFFICIENT;
+
+    for (uint32_t i = 0; i < count; i++) {
+        snprintf(properties[i].extensionName, XR_MAX_EXTENSION_NAME_SIZE, "%s", SupportedExtensions(i));
+        properties[i].extensionVersion = 1;
+    }
+    return XR_SUCCESS;
+}
+
+XrResult xrCreateInstance(const XrInstanceCreateInfo* createInfo, XrInstance* instance) {
+    HeadlessConfig config = GetHeadlessConfig();
+    if (config.refreshRate <= 0.0f) config.refreshRate = 72.0f;
+    SetHeadlessConfig(config);
+
+    for (uint32_t i = 0; i < createInfo->enabledExtensionCount; i++) {
+        bool found = false;
+        for (uint32_t e = 0; SupportedExtensions(e); e++) {
+            if (strcmp(createInfo->enabledExtensionNames[i], SupportedExtensions(e)) == 0) found = true;
+        }
+        if (!found) {
+            LOGE("Extension not supported: %s", createInfo->enabledExtensionNames[i]);
+            return XR_ERROR_EXTENSION_NOT_PRESENT;
+        }
+    }
+
+    sim.period = (XrDuration)(1e9 / config.refreshRate);
+    sim.epoch = NowNs();
+    sim.lastDisplayTime = sim.epoch;
+    sim.nextWakeTime = sim.epoch;
+    sim.framesWaited = 0;
+    sim.framesEnded = 0;
+    sim.pathCount = 0;
+    sim.actionCount = 0;
+    memset(sim.spaces, 0, sizeof(sim.spaces));
+
+    LOGI("Simulated runtime: %dx%d per eye @ %.0f Hz%s%s", config.eyeWidth, config.eyeHeight,
+         config.refreshRate, config.throttle ? ", throttled" : "",
+         config.handTracking ? ", hand tracking" : "");
+    *instance = (XrInstance)(uintptr_t)1;
+    return XR_SUCCESS;
+}
+
+XrResult xrDestroyInstance(XrInstance instance) {
+    (void)instance;
+    return XR_SUCCESS;
+}
+
+XrResult xrResultToString(XrInstance instance, XrResult value, char buffer[XR_MAX_RESULT_STRING_SIZE]) {
+    (void)instance;
+    const char* name = NULL;
+    switch (value) {
+        case XR_SUCCESS: name = "XR_SUCCESS"; break;
+        case XR_EVENT_UNAVAILABLE: name = "XR_EVENT_UNAVAILABLE"; break;
+        case XR_ERROR_VALIDATION_FAILURE: name = "XR_ERROR_VALIDATION_FAILURE"; break;
+        case XR_ERROR_HANDLE_INVALID: name = "XR_ERROR_HANDLE_INVALID"; break;
+        case XR_ERROR_SIZE_INSUFFICIENT: name = "XR_ERROR_SIZE_INSUFFICIENT"; break;
+        case XR_ERROR_FUNCTION_UNSUPPORTED: name = "XR_ERROR_FUNCTION_UNSUPPORTED"; break;
+        case XR_ERROR_EXTENSION_NOT_PRESENT: name = "XR_ERROR_EXTENSION_NOT_PRESENT"; break;
+        case XR_ERROR_PATH_COUNT_EXCEEDED: name = "XR_ERROR_PATH_COUNT_EXCEEDED"; break;
+        case XR_ERROR_LIMIT_REACHED: name = "XR_ERROR_LIMIT_REACHED"; break;
+        default: break;
+    }
+    if (name) {
+        snprintf(buffer, XR_MAX_RESULT_STRING_SIZE, "%s", name);
+    } else {
+        snprintf(buffer, XR_MAX_RESULT_STRING_SIZE, "XR_UNKNOWN_%s_%d", XR_SUCCEEDED(value) ? "SUCCESS" : "FAILURE", value);
+    }
+    return XR_SUCCESS;
+}
+
+XrResult xrGetSystem(XrInstance instance, const XrSystemGetInfo* getInfo, XrSystemId* systemId) {
+    (void)instance;
+    if (getInfo->formFactor != XR_FORM_FACTOR_HEAD_MOUNTED_DISPLAY) return XR_ERROR_FORM_FACTOR_UNSUPPORTED;
+    *systemId = 1;
+    return XR_SUCCESS;
+}
+
+XrResult xrGetSystemProperties(XrInstance instance, XrSystemId systemId, XrSystemProperties* properties) {
+    (void)instance;
+    properties->systemId = systemId;
+    properties->vendorId = 0;
+    snprintf(properties->systemName, XR_MAX_SYSTEM_NAME_SIZE, "RealityLib Headless");
+    properties->graphicsProperties.maxSwapchainImageWidth = 4096;
+    properties->graphicsProperties.maxSwapchainImageHeight = 4096;
+    properties->graphicsProperties.maxLayerCount = 16;
+    properties->trackingProperties.orientationTracking = XR_TRUE;
+    properties->trackingProperties.positionTracking = XR_TRUE;
+
+    for (XrBaseOutStructure* next = (XrBaseOutStructure*)properties->next; next; next = next->next) {
+        if (next->type == XR_TYPE_SYSTEM_HAND_TRACKING_PROPERTIES_EXT) {
+            ((XrSystemHandTrackingPropertiesEXT*)next)->supportsHandTracking = sim.config.handTracking;
+        }
+    }
+    return XR_SUCCESS;
+}
+
+XrResult xrEnumerateViewConfigurations(XrInstance instance, XrSystemId systemId, uint32_t capacity,
+                                       uint32_t* countOutput, XrViewConfigurationType* types) {
+    (void)instance;
+    (void)systemId;
+    *countOutput = 1;
+    if (capacity == 0) return XR_SUCCESS;
+    types[0] = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
+    return XR_SUCCESS;
+}
+
+XrResult xrEnumerateViewConfigurationViews(XrInstance instance, XrSystemId systemId, XrViewConfigurationType type,
+                                           uint32_t capacity, uint32_t* countOutput, XrViewConfigurationView* views) {
+    (void)instance;
+    (void)systemId;
+    if (type != XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO) return XR_ERROR_VIEW_CONFIGURATION_TYPE_UNSUPPORTED;
+    *countOutput = 2;
+    if (capacity == 0) return XR_SUCCESS;
+    if (capacity < 2) return XR_ERROR_SIZE_INSUFFICIENT;
+
+    // Quest-style headroom: the runtime allows ~1.5x the recommended size
+    HeadlessConfig config = GetHeadlessConfig();
+    for (uint32_t i = 0; i < 2; i++) {
+        views[i].recommendedImageRectWidth = (uint32_t)config.eyeWidth;
+        views[i].recommendedImageRectHeight = (uint32_t)config.eyeHeight;
+        views[i].maxImageRectWidth = (uint32_t)(config.eyeWidth * 3 / 2);
+        views[i].maxImageRectHeight = (uint32_t)(config.eyeHeight * 3 / 2);
+        views[i].recommendedSwapchainSampleCount = 1;
+        views[i].maxSwapchainSampleCount = 4;
+    }
+    return XR_SUCCESS;
+}
+
+static XrResult GetOpenGLESGraphicsRequirements(XrInstance instance, XrSystemId systemId,
+                                                XrGraphicsRequirementsOpenGLESKHR* requirements) {
+    (void)instance;
+    (void)systemId;
+    requirements->minApiVersionSupported = XR_MAKE_VERSION(3, 0, 0);
+    requirements->maxApiVersionSupported = XR_MAKE_VERSION(3, 2, 0);
+    return XR_SUCCESS;
+}
+
+static XrResult CreateHandTracker(XrSession session, const XrHandTrackerCreateInfoEXT* createInfo,
+                                  XrHandTrackerEXT* handTracker);
+static XrResult DestroyHandTracker(XrHandTrackerEXT handTracker);
+static XrResult LocateHandJoints(XrHandTrackerEXT handTracker, const XrHandJointsLocateInfoEXT* locateInfo,
+                                 XrHandJointLocationsEXT* locations);
+
+XrResult xrGetInstanceProcAddr(XrInstance instance, const char* name, PFN_xrVoidFunction* function) {
+    (void)instance;
+    *function = NULL;
+
+    if (strcmp(name, "xrGetOpenGLESGraphicsRequirementsKHR") == 0) {
+        *function = (PFN_xrVoidFunction)GetOpenGLESGraphicsRequirements;
+    } else if (sim.config.handTracking && strcmp(name, "xrCreateHandTrackerEXT") == 0) {
+        *function = (PFN_xrVoidFunction)CreateHandTracker;
+    } else if (sim.config.handTracking && strcmp(name, "xrDestroyHandTrackerEXT") == 0) {
+        *function = (PFN_xrVoidFunction)DestroyHandTracker;
+    } else if (sim.config.handTracking && strcmp(name, "xrLocateHandJointsEXT") == 0) {
+        *function = (PFN_xrVoidFunction)LocateHandJoints;
+    }
+    // xrInitializeLoaderKHR is deliberately absent: there is no loader to initialize
+
+    return *function ? XR_SUCCESS : XR_ERROR_FUNCTION_UNSUPPORTED;
+}
+
+// =============================================================================
+// Session
+// =============================================================================
+
+XrResult xrCreateSession(XrInstance instance, const XrSessionCreateInfo* createInfo, XrSession* session) {
+    (void)instance;
+    (void)createInfo;
+    sim.sessionState = XR_SESSION_STATE_UNKNOWN;
+    sim.exitRequested = false;
+    sim.eventHead = 0;
+    sim.eventCount = 0;
+    QueueSessionState(XR_SESSION_STATE_IDLE);
+    QueueSessionState(XR_SESSION_STATE_READY);
+    *session = (XrSession)(uintptr_t)1;
+    return XR_SUCCESS;
+}
+
+XrResult xrDestroySession(XrSession session) {
+    (void)session;
+    return XR_SUCCESS;
+}
+
+XrResult xrBeginSession(XrSession session, const XrSessionBeginInfo* beginInfo) {
+    (void)session;
+    (void)beginInfo;
+    if (sim.sessionState != XR_SESSION_STATE_READY) return XR_ERROR_SESSION_NOT_READY;
+    QueueSessionState(XR_SESSION_STATE_SYNCHRONIZED);
+    QueueSessionState(XR_SESSION_STATE_VISIBLE);
+    QueueSessionState(XR_SESSION_STATE_FOCUSED);
+    return XR_SUCCESS;
+}
+
+XrResult xrEndSession(XrSession session) {
+    (void)session;
+    if (sim.sessionState != XR_SESSION_STATE_STOPPING) return XR_ERROR_SESSION_NOT_STOPPING;
+    QueueSessionState(XR_SESSION_STATE_IDLE);
+    QueueSessionState(XR_SESSION_STATE_EXITING);
+    return XR_SUCCESS;
+}
+
+XrResult xrRequestExitSession(XrSession session) {
+    (void)session;
+    RequestSessionExit();
+    return XR_SUCCESS;
+}
+
+// =============================================================================
+// Spaces
+// =============================================================================
+
+static XrSpace AllocateSpace(SimSpace space) {
+    for (int i = 0; i < SIM_MAX_SPACES; i++) {
+        if (!sim.spaces[i].used) {
+            space.used = true;
+            sim.spaces[i] = space;
+            return (XrSpace)(uintptr_t)(i + 1);
+        }
+    }
+    return XR_NULL_HANDLE;
+}
+
+static SimSpace* LookupSpace(XrSpace handle) {
+    uintptr_t index = (uintptr_t)handle;
+    if (index == 0 || index > SIM_MAX_SPACES || !sim.spaces[index - 1].used) return NULL;
+    return &sim.spaces[index - 1];
+}
+
+XrResult xrCreateReferenceSpace(XrSession session, const XrReferenceSpaceCreateInfo* createInfo, XrSpace* space) {
+    (void)session;
+    SimSpace s = {
+        .kind = SIM_SPACE_REFERENCE,
+        .referenceType = createInfo->referenceSpaceType,
+        .offset = createInfo->poseInReferenceSpace
+    };
+    *space = AllocateSpace(s);
+    return *space ? XR_SUCCESS : XR_ERROR_LIMIT_REACHED;
+}
+
+static int HandFromPath(XrPath path);
+
+XrResult xrCreateActionSpace(XrSession session, const XrActionSpaceCreateInfo* createInfo, XrSpace* space) {
+    (void)session;
+    SimSpace s = {
+        .kind = SIM_SPACE_ACTION,
+        .hand = HandFromPath(createInfo->subactionPath),
+        .offset = createInfo->poseInActionSpace
+    };
+    if (s.hand < 0) s.hand = 0;
+    *space = AllocateSpace(s);
+    return *space ? XR_SUCCESS : XR_ERROR_LIMIT_REACHED;
+}
+
+XrResult xrDestroySpace(XrSpace space) {
+    SimSpace* s = LookupSpace(space);
+    if (!s) return XR_ERROR_HANDLE_INVALID;
+    s->used = false;
+    return XR_SUCCESS;
+}
+
+// Pose of a space relative to the stage origin
+static XrPosef SpaceToStage(const SimSpace* space, XrTime time) {
+    double t = ScriptSeconds(time);
+    XrPosef origin = { {0, 0, 0, 1}, {0, 0, 0} };
+
+    if (space->kind == SIM_SPACE_ACTION) {
+        origin = ScriptControllerPose(space->hand, t);
+    } else if (space->referenceType == XR_REFERENCE_SPACE_TYPE_VIEW) {
+        origin = ScriptHeadPose(t);
+    } else if (space->referenceType == XR_REFERENCE_SPACE_TYPE_LOCAL) {
+        origin.position.y = 1.6f;      // LOCAL starts at the initial head position
+    }
+    return PoseCompose(origin, space->offset);
+}
+
+static XrPosef LocateRelative(const SimSpace* space, const SimSpace* base, XrTime time) {
+    return PoseCompose(PoseInverse(SpaceToStage(base, time)), SpaceToStage(space, time));
+}
+
+XrResult xrLocateSpace(XrSpace space, XrSpace baseSpace, XrTime time, XrSpaceLocation* location) {
+    SimSpace* s = LookupSpace(space);
+    SimSpace* base = LookupSpace(baseSpace);
+    if (!s || !base) return XR_ERROR_HANDLE_INVALID;
+
+    location->pose = LocateRelative(s, base, time);
+    location->locationFlags = XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_VALID_BIT |
+                              XR_SPACE_LOCATION_POSITION_TRACKED_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT;
+
+    for (XrBaseOutStructure* next = (XrBaseOutStructure*)location->next; next; next = next->next) {
+        if (next->type != XR_TYPE_SPACE_VELOCITY) continue;
+
+        XrSpaceVelocity* velocity = (XrSpaceVelocity*)next;
+        XrPosef before = LocateRelative(s, base, time - SIM_VELOCITY_DT_NS);
+        float dt = SIM_VELOCITY_DT_NS * 1e-9f;
+        velocity->linearVelocity = VecScale(VecSub(location->pose.position, before.position), 1.0f / dt);
+        velocity->angularVelocity = AngularVelocity(before.orientation, location->pose.orientation, dt);
+        velocity->velocityFlags = XR_SPACE_VELOCITY_LINEAR_VALID_BIT | XR_SPACE_VELOCITY_ANGULAR_VALID_BIT;
+    }
+    return XR_SUCCESS;
+}
+
+XrResult xrLocateViews(XrSession session, const XrViewLocateInfo* viewLocateInfo, XrViewState* viewState,
+                       uint32_t viewCapacityInput, uint32_t* viewCountOutput, XrView* views) {
+    (void)session;
+    SimSpace* base = LookupSpace(viewLocateInfo->space);
+    if (!base) return XR_ERROR_HANDLE_INVALID;
+
+    *viewCountOutput = 2;
+    if (viewCapacityInput == 0) return XR_SUCCESS;
+    if (viewCapacityInput < 2) return XR_ERROR_SIZE_INSUFFICIENT;
+
+    viewState->viewStateFlags = XR_VIEW_STATE_POSITION_VALID_BIT | XR_VIEW_STATE_ORIENTATION_VALID_BIT |
+                                XR_VIEW_STATE_POSITION_TRACKED_BIT | XR_VIEW_STATE_ORIENTATION_TRACKED_BIT;
+
+    SimSpace head = { .used = true, .kind = SIM_SPACE_REFERENCE,
+                      .referenceType = XR_REFERENCE_SPACE_TYPE_VIEW, .offset = { {0, 0, 0, 1}, {0, 0, 0} } };
+    XrPosef headPose = LocateRelative(&head, base, viewLocateInfo->displayTime);
+
+    // 63 mm IPD; each eye's FOV is canted outward like a Quest panel
+    const float halfIpd = 0.0315f;
+    for (uint32_t i = 0; i < 2; i++) {
+        float side = i == 0 ? -1.0f : 1.0f;
+        XrPosef eye = { {0, 0, 0, 1}, { side * halfIpd, 0, 0 } };
+        views[i].pose = PoseCompose(headPose, eye);
+        views[i].fov = i == 0 ? (XrFovf){ -0.942f, 0.698f, 0.768f, -0.855f }
+                              : (XrFovf){ -0.698f, 0.942f, 0.768f, -0.855f };
+    }
+    return XR_SUCCESS;
+}
+
+// =============================================================================
+// Actions
+// =============================================================================
+
+XrResult xrStringToPath(XrInstance instance, const char* pathString, XrPath* path) {
+    (void)instance;
+    for (int i = 0; i < sim.pathCount; i++) {
+        if (strcmp(sim.paths[i], pathString) == 0) {
+            *path = (XrPath)(i + 1);
+            return XR_SUCCESS;
+        }
+    }
+    if (sim.pathCount >= SIM_MAX_PATHS) return XR_ERROR_PATH_COUNT_EXCEEDED;
+
+    snprintf(sim.paths[sim.pathCount], XR_MAX_PATH_LENGTH, "%s", pathString);
+    *path = (XrPath)(++sim.pathCount);
+    return XR_SUCCESS;
+}
+
+XrResult xrPathToString(XrInstance instance, XrPath path, uint32_t bufferCapacityInput,
+                        uint32_t* bufferCountOutput, char* buffer) {
+    (void)instance;
+    if (path == XR_NULL_PATH || path > (XrPath)sim.pathCount) return XR_ERROR_PATH_INVALID;
+    const char* s = sim.paths[path - 1];
+    *bufferCountOutput = (uint32_t)strlen(s) + 1;
+    if (bufferCapacityInput == 0) return XR_SUCCESS;
+    if (bufferCapacityInput < *bufferCountOutput) return XR_ERROR_SIZE_INSUFFICIENT;
+    memcpy(buffer, s, *bufferCountOutput);
+    return XR_SUCCESS;
+}
+
+static int HandFromPath(XrPath path) {
+    if (path == XR_NULL_PATH || path > (XrPath)sim.pathCount) return -1;
+    const char* s = sim.paths[path - 1];
+    if (strncmp(s, "/user/hand/left", 15) == 0) return 0;
+    if (strncmp(s, "/user/hand/right", 16) == 0) return 1;
+    return -1;
+}
+
+static SimAction* LookupAction(XrAction handle) {
+    uintptr_t index = (uintptr_t)handle;
+    if (index == 0 || index > (uintptr_t)sim.actionCount) return NULL;
+    return &sim.actions[index - 1];
+}
+
+XrResult xrCreateActionSet(XrInstance instance, const XrActionSetCreateInfo* createInfo, XrActionSet* actionSet) {
+    (void)instance;
+    (void)createInfo;
+    *actionSet = (XrActionSet)(uintptr_t)1;
+    return XR_SUCCESS;
+}
+
+XrResult xrDestroyActionSet(XrActionSet actionSet) {
+    (void)actionSet;
+    sim.actionCount = 0;
+    return XR_SUCCESS;
+}
+
+XrResult xrCreateAction(XrActionSet actionSet, const XrActionCreateInfo* createInfo, XrAction* action) {
+    (void)actionSet;
+    if (sim.actionCount >= SIM_MAX_ACTIONS) return XR_ERROR_LIMIT_REACHED;
+
+    SimAction* a = &sim.actions[sim.actionCount];
+    memset(a, 0, sizeof(*a));
+    snprintf(a->name, sizeof(a->name), "%s", createInfo->actionName);
+    a->type = createInfo->actionType;
+    *action = (XrAction)(uintptr_t)(++sim.actionCount);
+    return XR_SUCCESS;
+}
+
+XrResult xrSuggestInteractionProfileBindings(XrInstance instance,
+                                             const XrInteractionProfileSuggestedBinding* suggestedBindings) {
+    (void)instance;
+    (void)suggestedBindings;
+    return XR_SUCCESS;
+}
+
+XrResult xrAttachSessionActionSets(XrSession session, const XrSessionActionSetsAttachInfo* attachInfo) {
+    (void)session;
+    (void)attachInfo;
+    return XR_SUCCESS;
+}
+
+XrResult xrSyncActions(XrSession session, const XrActionsSyncInfo* syncInfo) {
+    (void)session;
+    (void)syncInfo;
+    if (sim.sessionState != XR_SESSION_STATE_FOCUSED) return XR_SESSION_NOT_FOCUSED;
+
+    double t = GetHeadlessScriptTime();
+    for (int i = 0; i < sim.actionCount; i++) {
+        SimAction* a = &sim.actions[i];
+        for (int hand = 0; hand < 2; hand++) {
+            a->previous[hand][0] = a->value[hand][0];
+            a->previous[hand][1] = a->value[hand][1];
+            ScriptActionValue(a->name, hand, t, &a->value[hand][0], &a->value[hand][1]);
+        }
+    }
+    return XR_SUCCESS;
+}
+
+// Unqualified queries (XR_NULL_PATH) read the left hand, like a menu button
+static int ActionHand(const XrActionStateGetInfo* getInfo) {
+    int hand = HandFromPath(getInfo->subactionPath);
+    return hand < 0 ? 0 : hand;
+}
+
+XrResult xrGetActionStateBoolean(XrSession session, const XrActionStateGetInfo* getInfo, XrActionStateBoolean* state) {
+    (void)session;
+    SimAction* a = LookupAction(getInfo->action);
+    if (!a) return XR_ERROR_HANDLE_INVALID;
+    if (a->type != XR_ACTION_TYPE_BOOLEAN_INPUT) return XR_ERROR_ACTION_TYPE_MISMATCH;
+
+    int hand = ActionHand(getInfo);
+    state->currentState = a->value[hand][0] > 0.5f;
+    state->changedSinceLastSync = state->currentState != (a->previous[hand][0] > 0.5f);
+    state->lastChangeTime = sim.lastDisplayTime;
+    state->isActive = XR_TRUE;
+    return XR_SUCCESS;
+}
+
+XrResult xrGetActionStateFloat(XrSession session, const XrActionStateGetInfo* getInfo, XrActionStateFloat* state) {
+    (void)session;
+    SimAction* a = LookupAction(getInfo->action);
+    if (!a) return XR_ERROR_HANDLE_INVALID;
+    if (a->type != XR_ACTION_TYPE_FLOAT_INPUT) return XR_ERROR_ACTION_TYPE_MISMATCH;
+
+    int hand = ActionHand(getInfo);
+    state->currentState = a->value[hand][0];
+    state->changedSinceLastSync = a->value[hand][0] != a->previous[hand][0];
+    state->lastChangeTime = sim.lastDisplayTime;
+    state->isActive = XR_TRUE;
+    return XR_SUCCESS;
+}
+
+XrResult xrGetActionStateVector2f(XrSession session, const XrActionStateGetInfo* getInfo, XrActionStateVector2f* state) {
+    (void)session;
+    SimAction* a = LookupAction(getInfo->action);
+    if (!a) return XR_ERROR_HANDLE_INVALID;
+    if (a->type != XR_ACTION_TYPE_VECTOR2F_INPUT) return XR_ERROR_ACTION_TYPE_MISMATCH;
+
+    int hand = ActionHand(getInfo);
+    state->currentState = (XrVector2f){ a->value[hand][0], a->value[hand][1] };
+    state->changedSinceLastSync = a->value[hand][0] != a->previous[hand][0] ||
+                                  a->value[hand][1] != a->previous[hand][1];
+    state->lastChangeTime = sim.lastDisplayTime;
+    state->isActive = XR_TRUE;
+    return XR_SUCCESS;
+}
+
+XrResult xrApplyHapticFeedback(XrSession session, const XrHapticActionInfo* hapticActionInfo,
+                               const XrHapticBaseHeader* hapticFeedback) {
+    (void)session;
+    (void)hapticActionInfo;
+    (void)hapticFeedback;
+    return XR_SUCCESS;
+}
+
+XrResult xrStopHapticFeedback(XrSession session, const XrHapticActionInfo* hapticActionInfo) {
+    (void)session;
+    (void)hapticActionInfo;
+    return XR_SUCCESS;
+}
+
+// =============================================================================
+// Hand Tracking (XR_EXT_hand_tracking)
+// =============================================================================
+
+static XrResult CreateHandTracker(XrSession session, const XrHandTrackerCreateInfoEXT* createInfo,
+                                  XrHandTrackerEXT* handTracker) {
+    (void)session;
+    *handTracker = (XrHandTrackerEXT)(uintptr_t)(createInfo->hand == XR_HAND_LEFT_EXT ? 1 : 2);
+    return XR_SUCCESS;
+}
+
+static XrResult DestroyHandTracker(XrHandTrackerEXT handTracker) {
+    (void)handTracker;
+    return XR_SUCCESS;
+}
+
+static XrResult LocateHandJoints(XrHandTrackerEXT handTracker, const XrHandJointsLocateInfoEXT* locateInfo,
+                                 XrHandJointLocationsEXT* locations) {
+    int hand = (uintptr_t)handTracker == 1 ? 0 : 1;
+    SimSpace* base = LookupSpace(locateInfo->baseSpace);
+    if (!base) return XR_ERROR_HANDLE_INVALID;
+    if (locations->jointCount != XR_HAND_JOINT_COUNT_EXT) return XR_ERROR_VALIDATION_FAILURE;
+
+    XrPosef joints[XR_HAND_JOINT_COUNT_EXT];
+    XrPosef before[XR_HAND_JOINT_COUNT_EXT];
+    float radii[XR_HAND_JOINT_COUNT_EXT];
+    double t = ScriptSeconds(locateInfo->time);
+    ScriptHandJoints(hand, t, joints, radii);
+    ScriptHandJoints(hand, t - SIM_VELOCITY_DT_NS * 1e-9, before, radii);
+
+    XrPosef toBase = PoseInverse(SpaceToStage(base, locateInfo->time));
+    locations->isActive = XR_TRUE;
+    for (uint32_t j = 0; j < XR_HAND_JOINT_COUNT_EXT; j++) {
+        locations->jointLocations[j].pose = PoseCompose(toBase, joints[j]);
+        locations->jointLocations[j].radius = radii[j];
+        locations->jointLocations[j].locationFlags =
+            XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_VALID_BIT |
+            XR_SPACE_LOCATION_POSITION_TRACKED_BIT | XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT;
+    }
+
+    for (XrBaseOutStructure* next = (XrBaseOutStructure*)locations->next; next; next = next->next) {
+        if (next->type != XR_TYPE_HAND_JOINT_VELOCITIES_EXT) continue;
+
+        XrHandJointVelocitiesEXT* velocities = (XrHandJointVelocitiesEXT*)next;
+        float dt = SIM_VELOCITY_DT_NS * 1e-9f;
+        for (uint32_t j = 0; j < velocities->jointCount && j < XR_HAND_JOINT_COUNT_EXT; j++) {
+            XrVector3f delta = QuatRotate(toBase.orientation, VecSub(joints[j].position, before[j].position));
+            velocities->jointVelocities[j].linearVelocity = VecScale(delta, 1.0f / dt);
+            velocities->jointVelocities[j].angularVelocity =
+                QuatRotate(toBase.orientation, AngularVelocity(before[j].orientation, joints[j].orientation, dt));
+            velocities->jointVelocities[j].velocityFlags =
+                XR_SPACE_VELOCITY_LINEAR_VALID_BIT | XR_SPACE_VELOCITY_ANGULAR_VALID_BIT;
+        }
+    }
+    return XR_SUCCESS;
+}
+
+// =============================================================================
+// Swapchains
+// =============================================================================
+
+XrResult xrEnumerateSwapchainFormats(XrSession session, uint32_t formatCapacityInput,
+                                     uint32_t* formatCountOutput, int64_t* formats) {
+    (void)session;
+    static const int64_t supported[] = {
+        GL_SRGB8_ALPHA8, GL_RGBA8, GL_DEPTH_COMPONENT16, GL_DEPTH_COMPONENT24, GL_DEPTH24_STENCIL8
+    };
+    uint32_t count = sizeof(supported) / sizeof(supported[0]);
+    *formatCountOutput = count;
+    if (formatCapacityInput == 0) return XR_SUCCESS;
+    if (formatCapacityInput < count) return XR_ERROR_SIZE_INSUFFICIENT;
+    memcpy(formats, supported, sizeof(supported));
+    return XR_SUCCESS;
+}
+
+XrResult xrCreateSwapchain(XrSession session, const XrSwapchainCreateInfo* createInfo, XrSwapchain* swapchain) {
+    (void)session;
+    SimSwapchain* sc = calloc(1, sizeof(SimSwapchain));
+    if (!sc) return XR_ERROR_OUT_OF_MEMORY;
+
+    // Sample count is ignored: images are always single-sampled textures
+    sc->target = createInfo->arraySize > 1 ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
+    glGenTextures(SIM_SWAPCHAIN_IMAGES, sc->images);
+    for (int i = 0; i < SIM_SWAPCHAIN_IMAGES; i++) {
+        glBindTexture(sc->target, sc->images[i]);
+        if (sc->target == GL_TEXTURE_2D_ARRAY) {
+            glTexStorage3D(sc->target, createInfo->mipCount, (GLenum)createInfo->format,
+                           (GLsizei)createInfo->width, (GLsizei)createInfo->height, (GLsizei)createInfo->arraySize);
+        } else {
+            glTexStorage2D(sc->target, createInfo->mipCount, (GLenum)createInfo->format,
+                           (GLsizei)createInfo->width, (GLsizei)createInfo->height);
+        }
+    }
+    glBindTexture(sc->target, 0);
+
+    if (glGetError() != GL_NO_ERROR) {
+        LOGE("Failed to allocate %ux%u swapchain images", createInfo->width, createInfo->height);
+        glDeleteTextures(SIM_SWAPCHAIN_IMAGES, sc->images);
+        free(sc);
+        return XR_ERROR_SWAPCHAIN_FORMAT_UNSUPPORTED;
+    }
+
+    *swapchain = (XrSwapchain)sc;
+    return XR_SUCCESS;
+}
+
+XrResult xrDestroySwapchain(XrSwapchain swapchain) {
+    SimSwapchain* sc = (SimSwapchain*)swapchain;
+    if (!sc) return XR_ERROR_HANDLE_INVALID;
+    glDeleteTextures(SIM_SWAPCHAIN_IMAGES, sc->images);
+    free(sc);
+    return XR_SUCCESS;
+}
+
+XrResult xrEnumerateSwapchainImages(XrSwapchain swapchain, uint32_t imageCapacityInput,
+                                    uint32_t* imageCountOutput, XrSwapchainImageBaseHeader* images) {
+    SimSwapchain* sc = (SimSwapchain*)swapchain;
+    *imageCountOutput = SIM_SWAPCHAIN_IMAGES;
+    if (imageCapacityInput == 0) return XR_SUCCESS;
+    if (imageCapacityInput < SIM_SWAPCHAIN_IMAGES) return XR_ERROR_SIZE_INSUFFICIENT;
+
+    XrSwapchainImageOpenGLESKHR* glImages = (XrSwapchainImageOpenGLESKHR*)images;
+    for (uint32_t i = 0; i < SIM_SWAPCHAIN_IMAGES; i++) {
+        glImages[i].image = sc->images[i];
+    }
+    return XR_SUCCESS;
+}
+
+XrResult xrAcquireSwapchainImage(XrSwapchain swapchain, const XrSwapchainImageAcquireInfo* acquireInfo,
+                                 uint32_t* index) {
+    (void)acquireInfo;
+    SimSwapchain* sc = (SimSwapchain*)swapchain;
+    *index = sc->nextImage;
+    sc->nextImage = (sc->nextImage + 1) % SIM_SWAPCHAIN_IMAGES;
+    return XR_SUCCESS;
+}
+
+XrResult xrWaitSwapchainImage(XrSwapchain swapchain, const XrSwapchainImageWaitInfo* waitInfo) {
+    (void)swapchain;
+    (void)waitInfo;
+    return XR_SUCCESS;
+}
+
+XrResult xrReleaseSwapchainImage(XrSwapchain swapchain, const XrSwapchainImageReleaseInfo* releaseInfo) {
+    (void)swapchain;
+    (void)releaseInfo;
+    return XR_SUCCESS;
+}
+
+// =============================================================================
+// Frame Loop
+// =============================================================================
+
+XrResult xrWaitFrame(XrSession session, const XrFrameWaitInfo* frameWaitInfo, XrFrameState* frameState) {
+    (void)session;
+    (void)frameWaitInfo;
+
+    if (sim.config.throttle) {
+        // Release one period before the frame is displayed, like a real compositor
+        XrTime now = NowNs();
+        if (now > sim.nextWakeTime + sim.period) sim.nextWakeTime = now;   // Fell behind: resync
+        SleepUntilNs(sim.nextWakeTime);
+        sim.lastDisplayTime = sim.nextWakeTime + sim.period;
+        sim.nextWakeTime += sim.period;
+    } else {
+        // Free-running: display times advance on the simulated clock only
+        sim.lastDisplayTime = sim.epoch + (XrTime)(sim.framesWaited + 1) * sim.period;
+    }
+    sim.framesWaited++;
+
+    frameState->predictedDisplayTime = sim.lastDisplayTime;
+    frameState->predictedDisplayPeriod = sim.period;
+    frameState->shouldRender = sim.sessionState == XR_SESSION_STATE_VISIBLE ||
+                               sim.sessionState == XR_SESSION_STATE_FOCUSED;
+    return XR_SUCCESS;
+}
+
+XrResult xrBeginFrame(XrSession session, const XrFrameBeginInfo* frameBeginInfo) {
+    (void)session;
+    (void)frameBeginInfo;
+    return XR_SUCCESS;
+}
+
+XrResult xrEndFrame(XrSession session, const XrFrameEndInfo* frameEndInfo) {
+    (void)session;
+    (void)frameEndInfo;
+    sim.framesEnded++;
+    if (sim.config.frameLimit > 0 && sim.framesEnded >= (uint64_t)sim.config.frameLimit) {
+        RequestSessionExit();
+    }
+    if (sim.config.replayPath && IsInputPlaybackFinished()) {
+        RequestSessionExit();
+    }
+    return XR_SUCCESS;
+}
+
+// =============================================================================
+// Surfaceless EGL
+// =============================================================================
+
+// Kept here so realitylib_vr.c only needs the display hook, not Mesa specifics
+EGLDisplay GetHeadlessEGLDisplay(void) {
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (getPlatformDisplay) {
+        EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+        if (display != EGL_NO_DISPLAY) return display;
+    }
+    LOGI("Surfaceless EGL platform unavailable, falling back to the default display");
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+// =============================================================================
+// Entry Point Helpers
+// =============================================================================
+
+void PrintHeadlessOptions(void) {
+    fprintf(stderr,
+        "  --frames N       exit after N frames (default: run until closed)\n"
+        "  --size WxH       per-eye resolution (default 1440x1584)\n"
+        "  --refresh HZ     simulated refresh rate (default 72)\n"
+        "  --throttle       pace xrWaitFrame to the refresh rate\n"
+        "  --no-hands       hide XR_EXT_hand_tracking\n"
+        "  --no-input       hold controllers and head at a rest pose\n"
+        "  --record FILE    record the app's input to FILE\n"
+        "  --replay FILE    replay input recorded with --record, then exit\n");
+}
+
+int ParseHeadlessOption(int argc, char** argv, int index, HeadlessConfig* config) {
+    const char* arg = argv[index];
+    const char* value = index + 1 < argc ? argv[index + 1] : NULL;
+
+    if (strcmp(arg, "--frames") == 0 && value) {
+        config->frameLimit = atoi(value);
+        return 2;
+    }
+    if (strcmp(arg, "--size") == 0 && value &&
+        sscanf(value, "%dx%d", &config->eyeWidth, &config->eyeHeight) == 2) {
+        return 2;
+    }
+    if (strcmp(arg, "--refresh") == 0 && value) {
+        config->refreshRate = (float)atof(value);
+        return 2;
+    }
+    if (strcmp(arg, "--throttle") == 0) {
+        config->throttle = true;
+        return 1;
+    }
+    if (strcmp(arg, "--no-hands") == 0) {
+        config->handTracking = false;
+        return 1;
+    }
+    if (strcmp(arg, "--no-input") == 0) {
+        config->scriptedInput = false;
+        return 1;
+    }
+    if (strcmp(arg, "--record") == 0 && value) {
+        config->recordPath = value;
+        return 2;
+    }
+    if (strcmp(arg, "--replay") == 0 && value) {
+        config->replayPath = value;
+        return 2;
+    }
+    return 0;
+}
+
+void RunHeadlessApp(void) {
+    ANativeActivity activity = {
+        .internalDataPath = ".",
+        .externalDataPath = "."
+    };
+    struct android_app app = {
+        .activity = &activity
+    };
+
+    if (sim.config.recordPath && !StartInputRecording(sim.config.recordPath)) return;
+    if (sim.config.replayPath && !StartInputPlayback(sim.config.replayPath)) return;
+
+    android_main(&app);
+
+    LOGI("Exited after %llu frames", (unsigned long long)sim.framesEnded);
+}
@@ -0,0 +1,99 @@
+/**
+ * RealityLib Headless - Simulated OpenXR Runtime for Linux
+ *
+ * Lets RealityLib and its samples run unchanged on a Linux box without a
+ * headset: EGL comes from Mesa's surfaceless platform (llvmpipe works), and
+ * this module stands in for the OpenXR loader with a single simulated
+ * stereo HMD. Views, controllers and hands follow a deterministic script
+ * driven by the simulated frame clock, so two runs of the same build see
+ * the same input. Swapchains are plain offscreen GL textures.
+ *
+ * Intended for local performance-regression runs, not for visual output.
+ */
+
+#ifndef REALITYLIB_HEADLESS_H
+#define REALITYLIB_HEADLESS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// =============================================================================
+// Configuration
+// =============================================================================
+
+typedef struct {
+    int eyeWidth;               // Recommended per-eye width in pixels
+    int eyeHeight;              // Recommended per-eye height in pixels
+    float refreshRate;          // Simulated display refresh rate (Hz)
+    bool throttle;              // Hold xrWaitFrame to the refresh rate (false = run flat out)
+    int frameLimit;             // Request session exit after this many frames (0 = never)
+    bool handTracking;          // Expose XR_EXT_hand_tracking with scripted hands
+    bool scriptedInput;         // Animate controllers/head (false = hold a rest pose)
+    const char* recordPath;     // Record the app's input to this file (NULL = off)
+    const char* replayPath;     // Replay a recording instead of the script, exit at its end (NULL = off)
+} HeadlessConfig;
+
+/**
+ * Get the default configuration
+ * Quest-like 1440x1584 eyes at 72 Hz, unthrottled, hands enabled
+ */
+HeadlessConfig GetHeadlessDefaultConfig(void);
+
+/**
+ * Replace the runtime configuration
+ * Call this before InitApp(); resolution and extensions are read when
+ * the instance is created
+ */
+void SetHeadlessConfig(HeadlessConfig config);
+
+/**
+ * Get the active runtime configuration
+ */
+HeadlessConfig GetHeadlessConfig(void);
+
+// =============================================================================
+// Simulated Clock
+// =============================================================================
+
+/**
+ * Get the number of frames the simulated compositor has accepted
+ */
+uint64_t GetHeadlessFrameCount(void);
+
+/**
+ * Get the simulated display time of the current frame in seconds
+ * The input script is a pure function of this value
+ */
+double GetHeadlessScriptTime(void);
+
+// =============================================================================
+// Entry Point Helpers
+// =============================================================================
+
+/**
+ * Parse one runtime option (--frames, --size, --refresh, --throttle, ...)
+ * @param index Position of the option in argv
+ * @return Number of arguments consumed, 0 if argv[index] is not a runtime option
+ */
+int ParseHeadlessOption(int argc, char** argv, int index, HeadlessConfig* config);
+
+/**
+ * Print the runtime options to stderr (for --help output)
+ */
+void PrintHeadlessOptions(void);
+
+/**
+ * Build a stand-in android_app and call android_main() with it
+ * Returns once android_main() does; call SetHeadlessConfig() first
+ */
+void RunHeadlessApp(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REALITYLIB_HEADLESS_H
@@ -0,0 +1,29 @@
+/**
+ * RealityLib Headless - Default Entry Point
+ *
+ * main() for the headless sample builds: parses the runtime options and
+ * runs the sample's android_main(). Programs with their own options (the
+ * benchmark) provide main() themselves and reuse the helpers.
+ */
+
+#include "realitylib_headless.h"
+#include <stdio.h>
+#include <string.h>
+
+int main(int argc, char** argv) {
+    HeadlessConfig config = GetHeadlessDefaultConfig();
+
+    for (int i = 1; i < argc; ) {
+        int consumed = ParseHeadlessOption(argc, argv, i, &config);
+        if (consumed == 0) {
+            fprintf(stderr, "Usage: %s [options]\n", argv[0]);
+            PrintHeadlessOptions();
+            return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+        i += consumed;
+    }
+
+    SetHeadlessConfig(config);
+    RunHeadlessApp();
+    return 0;
+}
@@ -64,8 +64,6 @@ typedef struct {
     
     // Hand tracking state
     bool handTrackingEnabled;
-    bool leftPinchReady;   // For detecting pinch press/release
-    bool rightPinchReady;
     
     // Initialized flag
     bool initialized;
@@ -238,7 +236,17 @@ static void DrawControllers(void) {
 // Hand Tracking Visualization
 // =============================================================================
 
-// Draw a synthetic hand based on controller pose and input
+// Place one joint of a synthetic hand
+static void SetHandPoseJoint(VRHandJoints* joints, HandJoint joint, Vector3 position, float radius) {
+    joints->x[joint] = position.x;
+    joints->y[joint] = position.y;
+    joints->z[joint] = position.z;
+    joints->radius[joint] = radius;
+    joints->validMask |= 1u << joint;
+}
+
+// Draw a synthetic hand based on controller pose and input. It is posed as
+// a full tracked-hand skeleton, so it goes through the instanced hand renderer
 static void DrawControllerHand(ControllerHand hand, VRController controller, Color color) {
     if (!controller.isTracking) return;
     
@@ -259,13 +267,11 @@ static void DrawControllerHand(ControllerHand hand, VRController controller, Col
     // Palm position
     Vector3 palm = Vector3Add(pos, Vector3Scale(forward, -0.02f));
     
-    // Draw wrist to palm
-    DrawVRLine3D(wrist, palm, color);
-    DrawVRSphere(wrist, 0.012f, color);
-    DrawVRSphere(palm, 0.015f, color);
+    VRHandJoints joints = {0};
+    SetHandPoseJoint(&joints, HAND_JOINT_WRIST, wrist, 0.012f);
+    SetHandPoseJoint(&joints, HAND_JOINT_PALM, palm, 0.015f);
     
     // Finger base positions (spread across palm)
-    float fingerSpread = 0.015f;
     Vector3 fingerBases[5];
     fingerBases[0] = Vector3Add(palm, Vector3Scale(right, handSign * 0.025f));  // Thumb
     fingerBases[1] = Vector3Add(palm, Vector3Scale(right, handSign * 0.015f));  // Index
@@ -282,7 +288,13 @@ static void DrawControllerHand(ControllerHand hand, VRController controller, Col
     float fingerLengths[5] = {0.03f, 0.045f, 0.05f, 0.045f, 0.035f};
     float curls[5] = {thumbCurl, indexCurl, otherCurl, otherCurl, otherCurl};
     
-    // Draw each finger
+    // First joint of each finger (the thumb has no intermediate joint)
+    static const HandJoint fingerJoints[5] = {
+        HAND_JOINT_THUMB_METACARPAL, HAND_JOINT_INDEX_METACARPAL, HAND_JOINT_MIDDLE_METACARPAL,
+        HAND_JOINT_RING_METACARPAL, HAND_JOINT_LITTLE_METACARPAL
+    };
+    
+    // Pose each finger
     for (int f = 0; f < 5; f++) {
         Vector3 base = fingerBases[f];
         float len = fingerLengths[f];
@@ -306,7 +318,7 @@ static void DrawControllerHand(ControllerHand hand, VRController controller, Col
         }
         fingerDir = Vector3Normalize(fingerDir);
         
-        // Draw finger segments
+        // Finger joints along the finger
         Vector3 mid = Vector3Add(base, Vector3Scale(fingerDir, len * 0.5f));
         Vector3 tip = Vector3Add(base, Vector3Scale(fingerDir, len));
         
@@ -316,10 +328,18 @@ static void DrawControllerHand(ControllerHand hand, VRController controller, Col
             tip = Vector3Add(tip, curlDir);
         }
         
-        DrawVRLine3D(base, mid, color);
-        DrawVRLine3D(mid, tip, color);
-        DrawVRSphere(tip, 0.008f, WHITE);
+        Vector3 distal = Vector3Scale(Vector3Add(mid, tip), 0.5f);
+        HandJoint joint = fingerJoints[f];
+        SetHandPoseJoint(&joints, joint++, base, 0.008f);
+        if (f > 0) {
+            SetHandPoseJoint(&joints, joint++, Vector3Scale(Vector3Add(base, mid), 0.5f), 0.008f);
+        }
+        SetHandPoseJoint(&joints, joint++, mid, 0.008f);
+        SetHandPoseJoint(&joints, joint++, distal, 0.008f);
+        SetHandPoseJoint(&joints, joint, tip, 0.008f);
     }
+    
+    DrawHandPose(hand, &joints, color);
 }
 
 static void DrawHands(void) {
@@ -331,31 +351,33 @@ static void DrawHands(void) {
     
     if (leftHandTracked) {
         // Real hand tracking - draw skeleton
-        VRHand leftHand = GetLeftHand();
+        const VRHand* leftHand = GetHandRef(CONTROLLER_LEFT);
         
         DrawHandSkeleton(CONTROLLER_LEFT, SKYBLUE);
         DrawVRSphere(GetIndexTip(CONTROLLER_LEFT), 0.01f, WHITE);
         DrawVRSphere(GetThumbTip(CONTROLLER_LEFT), 0.01f, WHITE);
         
-        if (leftHand.isPinching) {
+        if (leftHand->isPinching) {
             Vector3 pinchPos = GetPinchPosition(CONTROLLER_LEFT);
             DrawVRSphere(pinchPos, 0.02f, YELLOW);
         }
         
-        if (leftHand.isPointing) {
+        if (leftHand->isPointing) {
             Vector3 palmPos = GetPalmPosition(CONTROLLER_LEFT);
             Vector3 pointDir = GetPointingDirection(CONTROLLER_LEFT);
             Vector3 rayEnd = Vector3Add(palmPos, Vector3Scale(pointDir, 1.0f));
             DrawVRLine3D(palmPos, rayEnd, MAGENTA);
         }
         
-        if (leftHand.isFist) {
+        if (leftHand->isFist) {
             Vector3 palmPos = GetPalmPosition(CONTROLLER_LEFT);
             DrawVRSphere(palmPos, 0.03f, RED);
         }
     } else if (leftController.isTracking) {
         // Controller mode - draw synthetic hand
+        BeginVRDrawSpace(VR_SPACE_LEFT_CONTROLLER);
         DrawControllerHand(CONTROLLER_LEFT, leftController, SKYBLUE);
+        EndVRDrawSpace();
     }
     
     // Draw right hand
@@ -363,31 +385,33 @@ static void DrawHands(void) {
     
     if (rightHandTracked) {
         // Real hand tracking - draw skeleton
-        VRHand rightHand = GetRightHand();
+        const VRHand* rightHand = GetHandRef(CONTROLLER_RIGHT);
         
         DrawHandSkeleton(CONTROLLER_RIGHT, LIME);
         DrawVRSphere(GetIndexTip(CONTROLLER_RIGHT), 0.01f, WHITE);
         DrawVRSphere(GetThumbTip(CONTROLLER_RIGHT), 0.01f, WHITE);
         
-        if (rightHand.isPinching) {
+        if (rightHand->isPinching) {
             Vector3 pinchPos = GetPinchPosition(CONTROLLER_RIGHT);
             DrawVRSphere(pinchPos, 0.02f, YELLOW);
         }
         
-        if (rightHand.isPointing) {
+        if (rightHand->isPointing) {
             Vector3 palmPos = GetPalmPosition(CONTROLLER_RIGHT);
             Vector3 pointDir = GetPointingDirection(CONTROLLER_RIGHT);
             Vector3 rayEnd = Vector3Add(palmPos, Vector3Scale(pointDir, 1.0f));
             DrawVRLine3D(palmPos, rayEnd, MAGENTA);
         }
         
-        if (rightHand.isFist) {
+        if (rightHand->isFist) {
             Vector3 palmPos = GetPalmPosition(CONTROLLER_RIGHT);
             DrawVRSphere(palmPos, 0.03f, RED);
         }
     } else if (rightController.isTracking) {
         // Controller mode - draw synthetic hand
+        BeginVRDrawSpace(VR_SPACE_RIGHT_CONTROLLER);
         DrawControllerHand(CONTROLLER_RIGHT, rightController, LIME);
+        EndVRDrawSpace();
     }
 }
 
@@ -398,20 +422,18 @@ static void DrawHands(void) {
 static void HandleHandInput(void) {
     if (!world.handTrackingEnabled) return;
     
-    // =========================================================================
-    // RIGHT HAND PINCH: Spawn a cube at pinch position
-    // =========================================================================
-    if (IsHandTracked(CONTROLLER_RIGHT)) {
-        bool isPinching = IsHandPinching(CONTROLLER_RIGHT);
-        
-        if (isPinching && world.rightPinchReady) {
-            // Spawn a cube at the pinch position
+    // Pinch and fist fire once per gesture, so they come in as events
+    HandGestureEvent event;
+    while (PollHandGesture(&event)) {
+        // =====================================================================
+        // RIGHT HAND PINCH: Spawn a cube at pinch position
+        // =====================================================================
+        if (event.gesture == HAND_GESTURE_PINCH && event.hand == CONTROLLER_RIGHT) {
             int cubeIndex = (int)(RandomFloat() * NUM_FLOATING_CUBES);
             
-            // Get pinch position in hand tracking space
-            Vector3 pinchPos = GetPinchPosition(CONTROLLER_RIGHT);
-            
-            // Transform to world space (account for player position/rotation)
+            // Pinch position is in hand tracking space; transform to world
+            // space (account for player position/rotation)
+            Vector3 pinchPos = event.position;
             Vector3 playerPos = GetPlayerPosition();
             float playerYaw = GetPlayerYaw() * PI / 180.0f;
             
@@ -423,35 +445,20 @@ static void HandleHandInput(void) {
             
             world.cubePositions[cubeIndex] = worldPos;
             world.cubeColors[cubeIndex] = RandomColor();
-            world.rightPinchReady = false;
             
             LOGI("Pinch spawn! Cube at (%.2f, %.2f, %.2f)", worldPos.x, worldPos.y, worldPos.z);
         }
         
-        if (!isPinching) {
-            world.rightPinchReady = true;
-        }
-    }
-    
-    // =========================================================================
-    // LEFT HAND FIST: Teleport to origin
-    // =========================================================================
-    static bool fistReady = true;
-    if (IsHandTracked(CONTROLLER_LEFT)) {
-        bool isFist = IsHandFist(CONTROLLER_LEFT);
-        
-        if (isFist && fistReady) {
+        // =====================================================================
+        // LEFT HAND FIST: Teleport to origin
+        // =====================================================================
+        if (event.gesture == HAND_GESTURE_FIST && event.hand == CONTROLLER_LEFT) {
             SetPlayerPosition(Vector3Create(0.0f, 0.0f, 0.0f));
             SetPlayerYaw(0.0f);
             world.playerVelocityY = 0.0f;
             world.isGrounded = true;
-            fistReady = false;
             LOGI("Fist teleport to origin");
         }
-        
-        if (!isFist) {
-            fistReady = true;
-        }
     }
     
     // =========================================================================
@@ -712,8 +719,8 @@ void inLoop(struct android_app* app) {
     // Initialize world on first frame
     InitWorld();
     
-    // Update time (approximate 72Hz)
-    world.deltaTime = 1.0f / 72.0f;
+    // Update time (follows the display refresh rate and dropped frames)
+    world.deltaTime = GetFrameTime();
     world.time += world.deltaTime;
     
     // Update hand tracking (if enabled)
@@ -781,8 +788,8 @@ void android_main(struct android_app* app) {
     // Initialize hand tracking (optional - will gracefully fail if not supported)
     if (InitHandTracking()) {
         world.handTrackingEnabled = true;
-        world.leftPinchReady = true;
-        world.rightPinchReady = true;
+        SetHandGesturesEnabled(HAND_GESTURE_PINCH | HAND_GESTURE_FIST);
+        SetHandFilterEnabled(true);     // Steadier pinch/fist triggers
         LOGI("Hand tracking initialized successfully!");
     } else {
         world.handTrackingEnabled = false;
@@ -797,11 +804,14 @@ void android_main(struct android_app* app) {
         // Begin VR frame
         BeginVRMode();
         
-        // Sync controller input
-        SyncControllers();
-        
-        // Run user's game logic and drawing
-        inLoop(app);
+        // Skipped while the session is idle or a system menu has focus
+        if (ShouldUpdateThisFrame()) {
+            // Sync controller input
+            SyncControllers();
+            
+            // Run user's game logic and drawing
+            inLoop(app);
+        }
         
         // End VR frame (submits to headset)
         EndVRMode();
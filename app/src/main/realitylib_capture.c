@@ -0,0 +1,479 @@
+/**
+ * RealityLib Input Capture Implementation
+ *
+ * File layout (native little-endian, float32 values):
+ *
+ *   header   "RLIC", u32 version, u32 viewCount, u32 jointCount
+ *   frame    u32 size (bytes that follow), u32 sections, i64 displayTime,
+ *            then each section present, in this order:
+ *     views  viewCount x { XrPosef, XrFovf }
+ *     input  2 x { position, orientation, velocity, angularVelocity,
+ *                  trigger, grip, thumbstickX, thumbstickY, u32 buttons },
+ *            headset { position, orientation }
+ *     hand   (left, then right) u32 state, u32 valid mask,
+ *            joints x { position, orientation, radius } when tracking
+ *
+ * Sections are filled as the app reads each source during the frame and
+ * written in one block by EndVRMode(). Playback reads the whole record in
+ * BeginVRMode() and hands each section out when the app asks for it.
+ */
+
+#include "realitylib_capture.h"
+#include "realitylib_hands.h"
+#include <android/log.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <openxr/openxr.h>
+
+#define LOG_TAG "RealityLib_Capture"
+#define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+
+#define CAPTURE_MAGIC "RLIC"
+#define CAPTURE_VERSION 1
+#define CAPTURE_MAX_VIEWS 2
+#define CAPTURE_MAX_FRAME_BYTES 4096
+
+// Section bits of a frame record
+#define CAPTURE_SECTION_VIEWS       0x1
+#define CAPTURE_SECTION_INPUT       0x2
+#define CAPTURE_SECTION_LEFT_HAND   0x4
+#define CAPTURE_SECTION_RIGHT_HAND  0x8
+
+// Controller button bits
+#define CAPTURE_BUTTON_THUMBSTICK   0x1
+#define CAPTURE_BUTTON_A            0x2
+#define CAPTURE_BUTTON_B            0x4
+#define CAPTURE_BUTTON_MENU         0x8
+#define CAPTURE_BUTTON_TRACKING     0x10
+
+// Hand state bits
+#define CAPTURE_HAND_ACTIVE         0x1
+#define CAPTURE_HAND_TRACKING       0x2
+
+// =============================================================================
+// Capture State
+// =============================================================================
+
+// One frame of input, as recorded or as read back
+typedef struct {
+    uint32_t sections;
+    XrTime displayTime;
+    XrPosef viewPose[CAPTURE_MAX_VIEWS];
+    XrFovf viewFov[CAPTURE_MAX_VIEWS];
+    VRController controllers[2];
+    Vector3 headPosition;
+    Quaternion headOrientation;
+    VRHand hands[2];
+} CaptureFrame;
+
+typedef struct {
+    unsigned char data[CAPTURE_MAX_FRAME_BYTES];
+    uint32_t size;
+    uint32_t cursor;
+} CaptureBuffer;
+
+typedef struct {
+    FILE* file;
+    bool recording;
+    bool playing;
+    bool finished;
+    uint32_t viewCount;     // Views per frame (fixed by the first recorded frame)
+    int frameIndex;
+    XrTime firstDisplayTime;
+    CaptureFrame frame;
+    CaptureBuffer buffer;
+} CaptureState;
+
+static CaptureState capture = {0};
+
+// =============================================================================
+// Serialization
+// =============================================================================
+
+static void PutBytes(CaptureBuffer* buffer, const void* data, uint32_t size) {
+    memcpy(buffer->data + buffer->size, data, size);
+    buffer->size += size;
+}
+
+static void PutU32(CaptureBuffer* buffer, uint32_t value) {
+    PutBytes(buffer, &value, sizeof(value));
+}
+
+static void PutFloat(CaptureBuffer* buffer, float value) {
+    PutBytes(buffer, &value, sizeof(value));
+}
+
+static bool GetBytes(CaptureBuffer* buffer, void* data, uint32_t size) {
+    if (buffer->cursor + size > buffer->size) return false;
+    memcpy(data, buffer->data + buffer->cursor, size);
+    buffer->cursor += size;
+    return true;
+}
+
+static uint32_t GetU32(CaptureBuffer* buffer) {
+    uint32_t value = 0;
+    GetBytes(buffer, &value, sizeof(value));
+    return value;
+}
+
+static float GetFloat(CaptureBuffer* buffer) {
+    float value = 0.0f;
+    GetBytes(buffer, &value, sizeof(value));
+    return value;
+}
+
+static void WriteController(CaptureBuffer* buffer, const VRController* c) {
+    PutBytes(buffer, &c->position, sizeof(c->position));
+    PutBytes(buffer, &c->orientation, sizeof(c->orientation));
+    PutBytes(buffer, &c->velocity, sizeof(c->velocity));
+    PutBytes(buffer, &c->angularVelocity, sizeof(c->angularVelocity));
+    PutFloat(buffer, c->trigger);
+    PutFloat(buffer, c->grip);
+    PutFloat(buffer, c->thumbstickX);
+    PutFloat(buffer, c->thumbstickY);
+    PutU32(buffer, (c->thumbstickClick ? CAPTURE_BUTTON_THUMBSTICK : 0) |
+                   (c->buttonA ? CAPTURE_BUTTON_A : 0) |
+                   (c->buttonB ? CAPTURE_BUTTON_B : 0) |
+                   (c->menuButton ? CAPTURE_BUTTON_MENU : 0) |
+                   (c->isTracking ? CAPTURE_BUTTON_TRACKING : 0));
+}
+
+static void ReadController(CaptureBuffer* buffer, VRController* c) {
+    GetBytes(buffer, &c->position, sizeof(c->position));
+    GetBytes(buffer, &c->orientation, sizeof(c->orientation));
+    GetBytes(buffer, &c->velocity, sizeof(c->velocity));
+    GetBytes(buffer, &c->angularVelocity, sizeof(c->angularVelocity));
+    c->trigger = GetFloat(buffer);
+    c->grip = GetFloat(buffer);
+    c->thumbstickX = GetFloat(buffer);
+    c->thumbstickY = GetFloat(buffer);
+    uint32_t buttons = GetU32(buffer);
+    c->thumbstickClick = (buttons & CAPTURE_BUTTON_THUMBSTICK) != 0;
+    c->buttonA = (buttons & CAPTURE_BUTTON_A) != 0;
+    c->buttonB = (buttons & CAPTURE_BUTTON_B) != 0;
+    c->menuButton = (buttons & CAPTURE_BUTTON_MENU) != 0;
+    c->isTracking = (buttons & CAPTURE_BUTTON_TRACKING) != 0;
+}
+
+// Joints are only stored while the hand is tracked (~830 bytes per hand)
+static void WriteHand(CaptureBuffer* buffer, const VRHand* hand) {
+    uint32_t validMask = 0;
+    for (int j = 0; j < HAND_JOINT_COUNT; j++) {
+        if (hand->joints[j].isValid) validMask |= 1u << j;
+    }
+
+    PutU32(buffer, (hand->isActive ? CAPTURE_HAND_ACTIVE : 0) |
+                   (hand->isTracking ? CAPTURE_HAND_TRACKING : 0));
+    PutU32(buffer, validMask);
+
+    if (!hand->isTracking) return;
+    for (int j = 0; j < HAND_JOINT_COUNT; j++) {
+        PutBytes(buffer, &hand->joints[j].position, sizeof(Vector3));
+        PutBytes(buffer, &hand->joints[j].orientation, sizeof(Quaternion));
+        PutFloat(buffer, hand->joints[j].radius);
+    }
+}
+
+static void ReadHand(CaptureBuffer* buffer, VRHand* hand) {
+    uint32_t state = GetU32(buffer);
+    uint32_t validMask = GetU32(buffer);
+
+    hand->isActive = (state & CAPTURE_HAND_ACTIVE) != 0;
+    hand->isTracking = (state & CAPTURE_HAND_TRACKING) != 0;
+
+    for (int j = 0; j < HAND_JOINT_COUNT; j++) {
+        hand->joints[j].isValid = (validMask & (1u << j)) != 0;
+    }
+
+    if (!hand->isTracking) return;
+    for (int j = 0; j < HAND_JOINT_COUNT; j++) {
+        GetBytes(buffer, &hand->joints[j].position, sizeof(Vector3));
+        GetBytes(buffer, &hand->joints[j].orientation, sizeof(Quaternion));
+        hand->joints[j].radius = GetFloat(buffer);
+    }
+}
+
+static void WriteFrame(void) {
+    CaptureBuffer* buffer = &capture.buffer;
+    CaptureFrame* frame = &capture.frame;
+
+    buffer->size = 0;
+    PutU32(buffer, 0);  // Size, patched below
+    PutU32(buffer, frame->sections);
+    PutBytes(buffer, &frame->displayTime, sizeof(frame->displayTime));
+
+    if (frame->sections & CAPTURE_SECTION_VIEWS) {
+        for (uint32_t i = 0; i < capture.viewCount; i++) {
+            PutBytes(buffer, &frame->viewPose[i], sizeof(XrPosef));
+            PutBytes(buffer, &frame->viewFov[i], sizeof(XrFovf));
+        }
+    }
+    if (frame->sections & CAPTURE_SECTION_INPUT) {
+        WriteController(buffer, &frame->controllers[0]);
+        WriteController(buffer, &frame->controllers[1]);
+        PutBytes(buffer, &frame->headPosition, sizeof(Vector3));
+        PutBytes(buffer, &frame->headOrientation, sizeof(Quaternion));
+    }
+    if (frame->sections & CAPTURE_SECTION_LEFT_HAND) WriteHand(buffer, &frame->hands[0]);
+    if (frame->sections & CAPTURE_SECTION_RIGHT_HAND) WriteHand(buffer, &frame->hands[1]);
+
+    uint32_t size = buffer->size - sizeof(uint32_t);
+    memcpy(buffer->data, &size, sizeof(size));
+
+    if (fwrite(buffer->data, 1, buffer->size, capture.file) != buffer->size) {
+        LOGE("Recording write failed at frame %d, stopping", capture.frameIndex);
+        StopInputRecording();
+    }
+}
+
+static bool ReadFrame(void) {
+    CaptureBuffer* buffer = &capture.buffer;
+    CaptureFrame* frame = &capture.frame;
+
+    uint32_t size = 0;
+    if (fread(&size, sizeof(size), 1, capture.file) != 1) return false;
+    if (size > CAPTURE_MAX_FRAME_BYTES || fread(buffer->data, 1, size, capture.file) != size) {
+        LOGE("Recording is truncated or corrupt at frame %d", capture.frameIndex);
+        return false;
+    }
+    buffer->size = size;
+    buffer->cursor = 0;
+
+    frame->sections = GetU32(buffer);
+    GetBytes(buffer, &frame->displayTime, sizeof(frame->displayTime));
+
+    if (frame->sections & CAPTURE_SECTION_VIEWS) {
+        for (uint32_t i = 0; i < capture.viewCount; i++) {
+            GetBytes(buffer, &frame->viewPose[i], sizeof(XrPosef));
+            GetBytes(buffer, &frame->viewFov[i], sizeof(XrFovf));
+        }
+    }
+    if (frame->sections & CAPTURE_SECTION_INPUT) {
+        ReadController(buffer, &frame->controllers[0]);
+        ReadController(buffer, &frame->controllers[1]);
+        GetBytes(buffer, &frame->headPosition, sizeof(Vector3));
+        GetBytes(buffer, &frame->headOrientation, sizeof(Quaternion));
+    }
+    if (frame->sections & CAPTURE_SECTION_LEFT_HAND) ReadHand(buffer, &frame->hands[0]);
+    if (frame->sections & CAPTURE_SECTION_RIGHT_HAND) ReadHand(buffer, &frame->hands[1]);
+
+    return buffer->cursor == buffer->size;
+}
+
+// =============================================================================
+// Recording
+// =============================================================================
+
+bool StartInputRecording(const char* path) {
+    if (capture.recording || capture.playing) {
+        LOGE("Cannot record to %s: capture already in progress", path);
+        return false;
+    }
+
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        LOGE("Cannot create recording %s", path);
+        return false;
+    }
+    setvbuf(file, NULL, _IOFBF, 64 * 1024);
+
+    memset(&capture, 0, sizeof(capture));
+    capture.file = file;
+    capture.recording = true;
+    LOGI("Recording input to %s", path);
+    return true;
+}
+
+void StopInputRecording(void) {
+    if (!capture.recording) return;
+
+    fclose(capture.file);
+    capture.file = NULL;
+    capture.recording = false;
+    LOGI("Recorded %d frames", capture.frameIndex);
+}
+
+bool IsInputRecording(void) {
+    return capture.recording;
+}
+
+// =============================================================================
+// Playback
+// =============================================================================
+
+bool StartInputPlayback(const char* path) {
+    if (capture.recording || capture.playing) {
+        LOGE("Cannot play %s: capture already in progress", path);
+        return false;
+    }
+
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        LOGE("Cannot open recording %s", path);
+        return false;
+    }
+
+    char magic[4];
+    uint32_t header[3];
+    if (fread(magic, sizeof(magic), 1, file) != 1 || memcmp(magic, CAPTURE_MAGIC, 4) != 0 ||
+        fread(header, sizeof(header), 1, file) != 1) {
+        LOGE("%s is not an input recording", path);
+        fclose(file);
+        return false;
+    }
+    if (header[0] != CAPTURE_VERSION || header[1] > CAPTURE_MAX_VIEWS || header[2] != HAND_JOINT_COUNT) {
+        LOGE("%s: unsupported recording (version %u, %u views, %u joints)",
+             path, header[0], header[1], header[2]);
+        fclose(file);
+        return false;
+    }
+
+    memset(&capture, 0, sizeof(capture));
+    capture.file = file;
+    capture.playing = true;
+    capture.viewCount = header[1];
+    LOGI("Playing input from %s", path);
+    return true;
+}
+
+void StopInputPlayback(void) {
+    if (!capture.playing) return;
+
+    fclose(capture.file);
+    capture.file = NULL;
+    capture.playing = false;
+    LOGI("Played back %d frames", capture.frameIndex);
+}
+
+bool IsInputPlaybackActive(void) {
+    return capture.playing;
+}
+
+bool IsInputPlaybackFinished(void) {
+    return capture.finished;
+}
+
+// =============================================================================
+// Capture Clock
+// =============================================================================
+
+int GetInputCaptureFrame(void) {
+    return capture.frameIndex;
+}
+
+double GetInputCaptureTime(void) {
+    return (double)(capture.frame.displayTime - capture.firstDisplayTime) * 1e-9;
+}
+
+// =============================================================================
+// Frame Hooks (called from realitylib_vr.c and realitylib_hands.c)
+// =============================================================================
+
+void RecordFrameViews(XrTime displayTime, const XrView* views, uint32_t viewCount) {
+    if (!capture.recording) return;
+
+    if (viewCount > CAPTURE_MAX_VIEWS) viewCount = CAPTURE_MAX_VIEWS;
+
+    // The first frame fixes the view count and writes the file header
+    if (capture.frameIndex == 0 && capture.frame.sections == 0) {
+        uint32_t header[3] = { CAPTURE_VERSION, viewCount, HAND_JOINT_COUNT };
+        fwrite(CAPTURE_MAGIC, 4, 1, capture.file);
+        fwrite(header, sizeof(header), 1, capture.file);
+        capture.viewCount = viewCount;
+        capture.firstDisplayTime = displayTime;
+    }
+
+    capture.frame.sections = CAPTURE_SECTION_VIEWS;
+    capture.frame.displayTime = displayTime;
+    for (uint32_t i = 0; i < capture.viewCount && i < viewCount; i++) {
+        capture.frame.viewPose[i] = views[i].pose;
+        capture.frame.viewFov[i] = views[i].fov;
+    }
+}
+
+void RecordControllers(const VRController* controllers, const VRHeadset* headset) {
+    if (!capture.recording || capture.frame.sections == 0) return;
+
+    capture.frame.sections |= CAPTURE_SECTION_INPUT;
+    capture.frame.controllers[0] = controllers[0];
+    capture.frame.controllers[1] = controllers[1];
+    capture.frame.headPosition = headset->position;
+    capture.frame.headOrientation = headset->orientation;
+}
+
+void RecordHand(int hand, const VRHand* data) {
+    if (!capture.recording || capture.frame.sections == 0) return;
+
+    capture.frame.sections |= (hand == 0) ? CAPTURE_SECTION_LEFT_HAND : CAPTURE_SECTION_RIGHT_HAND;
+    capture.frame.hands[hand] = *data;
+}
+
+void RecordFrameEnd(void) {
+    if (!capture.recording || capture.frame.sections == 0) return;
+
+    WriteFrame();
+    capture.frameIndex++;
+    capture.frame.sections = 0;
+}
+
+bool PlaybackFrameViews(XrTime* displayTime, XrView* views, uint32_t viewCount) {
+    if (!capture.playing) return false;
+
+    if (!ReadFrame()) {
+        StopInputPlayback();
+        capture.finished = true;
+        return false;
+    }
+    if (capture.frameIndex == 0) {
+        capture.firstDisplayTime = capture.frame.displayTime;
+    }
+    capture.frameIndex++;
+
+    // Report the end as soon as the last frame is handed out, so a harness
+    // can exit without running a frame on live input
+    int next = fgetc(capture.file);
+    if (next == EOF) {
+        capture.finished = true;
+    } else {
+        ungetc(next, capture.file);
+    }
+
+    *displayTime = capture.frame.displayTime;
+    for (uint32_t i = 0; i < capture.viewCount && i < viewCount; i++) {
+        views[i].pose = capture.frame.viewPose[i];
+        views[i].fov = capture.frame.viewFov[i];
+    }
+    return true;
+}
+
+bool PlaybackControllers(VRController* controllers, VRHeadset* headset) {
+    if (!capture.playing) return false;
+
+    // A frame recorded without SyncControllers() leaves the input untouched
+    if (capture.frame.sections & CAPTURE_SECTION_INPUT) {
+        controllers[0] = capture.frame.controllers[0];
+        controllers[1] = capture.frame.controllers[1];
+        headset->position = capture.frame.headPosition;
+        headset->orientation = capture.frame.headOrientation;
+    }
+    return true;
+}
+
+bool PlaybackHand(int hand, VRHand* data) {
+    if (!capture.playing) return false;
+
+    uint32_t section = (hand == 0) ? CAPTURE_SECTION_LEFT_HAND : CAPTURE_SECTION_RIGHT_HAND;
+    if (capture.frame.sections & section) {
+        data->isActive = capture.frame.hands[hand].isActive;
+        data->isTracking = capture.frame.hands[hand].isTracking;
+        memcpy(data->joints, capture.frame.hands[hand].joints, sizeof(data->joints));
+    } else {
+        data->isActive = false;
+        data->isTracking = false;
+    }
+    return true;
+}
@@ -0,0 +1,98 @@
+/**
+ * RealityLib Input Capture Module
+ *
+ * Records everything the app reads from the runtime each frame (eye views,
+ * controllers, headset pose, hand joints and the predicted display time) to
+ * a compact binary file, and plays such a file back in place of live
+ * tracking. A recorded session replays frame-for-frame, so two builds can
+ * be compared on exactly the same workload.
+ *
+ * Usage:
+ *   1. Call StartInputRecording() or StartInputPlayback() (before or after InitApp())
+ *   2. Run the normal loop; BeginVRMode(), SyncControllers() and
+ *      UpdateHandTracking() record or replay transparently
+ *   3. Call StopInputRecording() / StopInputPlayback() when done
+ *
+ * Playback replaces the tracked values only: the runtime still paces the
+ * frame loop and receives the replayed eye poses with each submitted frame.
+ * Hands replay only if hand tracking was initialized on the playback device.
+ */
+
+#ifndef REALITYLIB_CAPTURE_H
+#define REALITYLIB_CAPTURE_H
+
+#include <stdbool.h>
+#include "realitylib_vr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// =============================================================================
+// Recording
+// =============================================================================
+
+/**
+ * Start writing one record per frame to a file
+ * @param path File to create (overwritten if it exists)
+ * @return true if the file was opened
+ */
+bool StartInputRecording(const char* path);
+
+/**
+ * Flush and close the recording
+ */
+void StopInputRecording(void);
+
+/**
+ * Check if a recording is in progress
+ */
+bool IsInputRecording(void);
+
+// =============================================================================
+// Playback
+// =============================================================================
+
+/**
+ * Start feeding recorded input to the app instead of live tracking
+ * @param path File written by StartInputRecording()
+ * @return true if the file was opened and its header is valid
+ */
+bool StartInputPlayback(const char* path);
+
+/**
+ * Stop playback and return to live tracking
+ */
+void StopInputPlayback(void);
+
+/**
+ * Check if recorded input is currently being fed to the app
+ */
+bool IsInputPlaybackActive(void);
+
+/**
+ * Check if the last recorded frame has been played back
+ * Playback stops by itself on the following frame and live tracking resumes
+ */
+bool IsInputPlaybackFinished(void);
+
+// =============================================================================
+// Capture Clock
+// =============================================================================
+
+/**
+ * Get the number of frames recorded or played back so far
+ */
+int GetInputCaptureFrame(void);
+
+/**
+ * Get the predicted display time of the current capture frame
+ * @return Seconds since the first frame of the recording
+ */
+double GetInputCaptureTime(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REALITYLIB_CAPTURE_H
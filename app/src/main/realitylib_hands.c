@@ -35,10 +35,62 @@ extern XrSpace GetXrStageSpace(void);
 extern XrTime GetPredictedDisplayTime(void);
 extern bool IsVRSessionRunning(void);
 
+// Hand renderer hooks (realitylib_vr.c)
+extern void RecordHandJoints(int hand, const VRHandJoints* joints, Color color);
+extern void RecordHandBones(int hand, const VRHandJoints* joints, Color color);
+
+// Input capture hooks (realitylib_capture.c)
+extern void RecordHand(int hand, const VRHand* data);
+extern bool PlaybackHand(int hand, VRHand* data);
+
 // =============================================================================
 // Hand Tracking State
 // =============================================================================
 
+// One frame of joint history (structure of arrays, like VRHandJoints)
+#define HAND_HISTORY_FRAMES 32
+#define HAND_GESTURE_QUEUE_SIZE 16
+
+typedef struct {
+    float time;
+    float x[HAND_JOINT_SOA_STRIDE];
+    float y[HAND_JOINT_SOA_STRIDE];
+    float z[HAND_JOINT_SOA_STRIDE];
+    float vx[HAND_JOINT_SOA_STRIDE];    // Linear velocity in m/s
+    float vy[HAND_JOINT_SOA_STRIDE];
+    float vz[HAND_JOINT_SOA_STRIDE];
+    uint32_t validMask;
+} HandHistoryFrame;
+
+typedef struct {
+    HandHistoryFrame history[HAND_HISTORY_FRAMES];
+    int head;                   // Newest entry
+    int count;
+    unsigned int detected;      // HandGesture bits of the latest update
+    float motionCooldown;       // No swipe/flick/tap before this time
+    bool pinchHeld;
+    bool dragging;
+    Vector3 pinchStart;
+    Vector3 pinchLast;
+} HandGestureState;
+
+// One-Euro filter state for both hands' joints, one lane per joint
+// (hand * HAND_JOINT_SOA_STRIDE + joint), so a single loop covers all 52
+#define HAND_FILTER_LANES (2 * HAND_JOINT_SOA_STRIDE)
+
+typedef struct {
+    float x[HAND_FILTER_LANES];         // Filtered positions
+    float y[HAND_FILTER_LANES];
+    float z[HAND_FILTER_LANES];
+    float vx[HAND_FILTER_LANES];        // Filtered velocities in m/s
+    float vy[HAND_FILTER_LANES];
+    float vz[HAND_FILTER_LANES];
+    float rawX[HAND_FILTER_LANES];      // Last raw positions, for velocities without runtime data
+    float rawY[HAND_FILTER_LANES];
+    float rawZ[HAND_FILTER_LANES];
+    uint32_t primed[2];                 // Joints with a previous sample, per hand
+} __attribute__((aligned(16))) HandFilterState;
+
 typedef struct {
     // Extension availability
     bool extensionSupported;
@@ -53,7 +105,18 @@ typedef struct {
     
     // Processed hand data
     VRHand hands[2];
+    VRHandJoints packed[2];     // Same joints as hands[], structure of arrays
     
+    // Gesture engine
+    HandGestureState gestures[2];
+    HandGestureEvent events[HAND_GESTURE_QUEUE_SIZE];
+    int eventCount;
+    int eventRead;
+    float gestureTime;          // Seconds of updates since init, the history's clock
+
+    // Joint filter
+    HandFilterState filter;
+
     // Function pointers (loaded dynamically)
     PFN_xrCreateHandTrackerEXT xrCreateHandTrackerEXT;
     PFN_xrDestroyHandTrackerEXT xrDestroyHandTrackerEXT;
@@ -62,6 +125,10 @@ typedef struct {
 
 static HandTrackingState htState = {0};
 
+// Returned for out-of-range hands, so the pointer accessors never return NULL
+static const VRHand emptyHand = {0};
+static const VRHandJoints emptyJoints = {0};
+
 // =============================================================================
 // Helper Functions
 // =============================================================================
@@ -95,11 +162,146 @@ static Quaternion XrQuatToQuaternion(XrQuaternionf q) {
     return (Quaternion){q.x, q.y, q.z, q.w};
 }
 
+// =============================================================================
+// Joint Filter (One-Euro)
+// =============================================================================
+
+#define HAND_FILTER_MIN_CUTOFF 1.5f         // Hz, for a still joint
+#define HAND_FILTER_BETA 4.0f               // Extra Hz per m/s of joint speed
+#define HAND_FILTER_VELOCITY_CUTOFF 1.0f    // Hz, smoothing of the speed that drives the cutoff
+#define HAND_FILTER_MAX_DT 0.1f             // A longer gap restarts every joint
+#define HAND_FILTER_TWO_PI 6.28318530718f
+
+static bool filterEnabled = false;
+static float filterMinCutoff = HAND_FILTER_MIN_CUTOFF;
+static float filterBeta = HAND_FILTER_BETA;
+
+// Filter both hands' joint positions in place. Every lane runs the same
+// arithmetic: a joint without a previous sample gets a blend weight of 1,
+// which restarts it at the raw position. Runtime joint velocities are used
+// where valid, otherwise they are differenced from the previous raw position
+static void FilterHandJoints(const XrHandJointVelocityEXT* velocities[2], float dt) {
+    HandFilterState* f = &htState.filter;
+    float px[HAND_FILTER_LANES], py[HAND_FILTER_LANES], pz[HAND_FILTER_LANES];
+    float ix[HAND_FILTER_LANES], iy[HAND_FILTER_LANES], iz[HAND_FILTER_LANES];
+    float restart[HAND_FILTER_LANES];
+    uint32_t valid[2];
+
+    bool restartAll = dt <= 0.0f || dt > HAND_FILTER_MAX_DT;
+    float invDt = restartAll ? 0.0f : 1.0f / dt;
+
+    // Gather raw positions and input velocities into lanes
+    for (int hand = 0; hand < 2; hand++) {
+        const VRHand* src = &htState.hands[hand];
+        const XrHandJointVelocityEXT* vel = velocities[hand];
+
+        valid[hand] = 0;
+        if (src->isTracking) {
+            for (int j = 0; j < HAND_JOINT_COUNT; j++) {
+                if (src->joints[j].isValid) valid[hand] |= 1u << j;
+            }
+        }
+        uint32_t primed = restartAll ? 0 : (f->primed[hand] & valid[hand]);
+        f->primed[hand] = valid[hand];
+
+        for (int j = 0; j < HAND_JOINT_SOA_STRIDE; j++) {
+            int lane = hand * HAND_JOINT_SOA_STRIDE + j;
+            Vector3 p = (j < HAND_JOINT_COUNT) ? src->joints[j].position : (Vector3){0, 0, 0};
+            bool hasPrevious = (primed >> j) & 1u;
+
+            px[lane] = p.x;
+            py[lane] = p.y;
+            pz[lane] = p.z;
+            restart[lane] = hasPrevious ? 0.0f : 1.0f;
+
+            if (vel && j < HAND_JOINT_COUNT &&
+                (vel[j].velocityFlags & XR_SPACE_VELOCITY_LINEAR_VALID_BIT)) {
+                ix[lane] = vel[j].linearVelocity.x;
+                iy[lane] = vel[j].linearVelocity.y;
+                iz[lane] = vel[j].linearVelocity.z;
+            } else if (hasPrevious) {
+                ix[lane] = (p.x - f->rawX[lane]) * invDt;
+                iy[lane] = (p.y - f->rawY[lane]) * invDt;
+                iz[lane] = (p.z - f->rawZ[lane]) * invDt;
+            } else {
+                ix[lane] = iy[lane] = iz[lane] = 0.0f;
+            }
+        }
+    }
+
+    // Filter all lanes at once (no branches, so the compiler can vectorize)
+    float velocityTau = 1.0f / (HAND_FILTER_TWO_PI * HAND_FILTER_VELOCITY_CUTOFF);
+    float velocityAlpha = dt / (dt + velocityTau);
+
+    for (int lane = 0; lane < HAND_FILTER_LANES; lane++) {
+        float keep = 1.0f - restart[lane];
+
+        float a = velocityAlpha * keep + restart[lane];
+        f->vx[lane] += (ix[lane] - f->vx[lane]) * a;
+        f->vy[lane] += (iy[lane] - f->vy[lane]) * a;
+        f->vz[lane] += (iz[lane] - f->vz[lane]) * a;
+
+        // Faster joints get a higher cutoff: less smoothing, less lag
+        float speed = sqrtf(f->vx[lane] * f->vx[lane] + f->vy[lane] * f->vy[lane] +
+                            f->vz[lane] * f->vz[lane]);
+        float tau = 1.0f / (HAND_FILTER_TWO_PI * (filterMinCutoff + filterBeta * speed));
+        a = dt / (dt + tau) * keep + restart[lane];
+        f->x[lane] += (px[lane] - f->x[lane]) * a;
+        f->y[lane] += (py[lane] - f->y[lane]) * a;
+        f->z[lane] += (pz[lane] - f->z[lane]) * a;
+
+        f->rawX[lane] = px[lane];
+        f->rawY[lane] = py[lane];
+        f->rawZ[lane] = pz[lane];
+
+        // The low-pass trails a moving joint by about tau seconds; lead it
+        // by the filtered velocity to make that up
+        float lead = tau * keep;
+        px[lane] = f->x[lane] + f->vx[lane] * lead;
+        py[lane] = f->y[lane] + f->vy[lane] * lead;
+        pz[lane] = f->z[lane] + f->vz[lane] * lead;
+    }
+
+    // Scatter the filtered positions back to the valid joints
+    for (int hand = 0; hand < 2; hand++) {
+        for (int j = 0; j < HAND_JOINT_COUNT; j++) {
+            if (!((valid[hand] >> j) & 1u)) continue;
+            int lane = hand * HAND_JOINT_SOA_STRIDE + j;
+            htState.hands[hand].joints[j].position = (Vector3){px[lane], py[lane], pz[lane]};
+        }
+    }
+}
+
 // =============================================================================
 // Gesture Detection Implementation
 // =============================================================================
 
-static void DetectGestures(VRHand* hand) {
+#define JOINT_BIT(joint) (1u << (joint))
+
+// Rebuild the packed snapshot from the joint records
+static void PackHandJoints(int hand) {
+    const VRHand* src = &htState.hands[hand];
+    VRHandJoints* dst = &htState.packed[hand];
+    
+    dst->validMask = 0;
+    for (int j = 0; j < HAND_JOINT_COUNT; j++) {
+        dst->x[j] = src->joints[j].position.x;
+        dst->y[j] = src->joints[j].position.y;
+        dst->z[j] = src->joints[j].position.z;
+        dst->radius[j] = src->joints[j].radius;
+        if (src->isTracking && src->joints[j].isValid) {
+            dst->validMask |= JOINT_BIT(j);
+        }
+    }
+}
+
+// Static pose flags, from the packed joints. Each pose has a looser
+// threshold to leave it than to enter it, so a hand held near a threshold
+// does not flicker between states
+static void DetectGestures(int index) {
+    VRHand* hand = &htState.hands[index];
+    const VRHandJoints* joints = &htState.packed[index];
+    
     if (!hand->isTracking) {
         hand->isPinching = false;
         hand->pinchStrength = 0.0f;
@@ -109,18 +311,27 @@ static void DetectGestures(VRHand* hand) {
         return;
     }
     
-    // Get key joints
-    VRHandJoint* thumbTip = &hand->joints[HAND_JOINT_THUMB_TIP];
-    VRHandJoint* indexTip = &hand->joints[HAND_JOINT_INDEX_TIP];
-    VRHandJoint* middleTip = &hand->joints[HAND_JOINT_MIDDLE_TIP];
-    VRHandJoint* ringTip = &hand->joints[HAND_JOINT_RING_TIP];
-    VRHandJoint* littleTip = &hand->joints[HAND_JOINT_LITTLE_TIP];
-    VRHandJoint* palm = &hand->joints[HAND_JOINT_PALM];
-    VRHandJoint* wrist = &hand->joints[HAND_JOINT_WRIST];
+    // Squared distance of every joint to the palm, in one branch-free pass
+    float palmX = joints->x[HAND_JOINT_PALM];
+    float palmY = joints->y[HAND_JOINT_PALM];
+    float palmZ = joints->z[HAND_JOINT_PALM];
+    float palmDist2[HAND_JOINT_SOA_STRIDE];
+    for (int j = 0; j < HAND_JOINT_SOA_STRIDE; j++) {
+        float dx = joints->x[j] - palmX;
+        float dy = joints->y[j] - palmY;
+        float dz = joints->z[j] - palmZ;
+        palmDist2[j] = dx * dx + dy * dy + dz * dz;
+    }
+    
+    uint32_t valid = joints->validMask;
     
     // Pinch detection - distance between thumb and index tips
-    if (thumbTip->isValid && indexTip->isValid) {
-        float pinchDist = Vector3Len(Vector3Sub(thumbTip->position, indexTip->position));
+    const uint32_t pinchJoints = JOINT_BIT(HAND_JOINT_THUMB_TIP) | JOINT_BIT(HAND_JOINT_INDEX_TIP);
+    if ((valid & pinchJoints) == pinchJoints) {
+        float dx = joints->x[HAND_JOINT_THUMB_TIP] - joints->x[HAND_JOINT_INDEX_TIP];
+        float dy = joints->y[HAND_JOINT_THUMB_TIP] - joints->y[HAND_JOINT_INDEX_TIP];
+        float dz = joints->z[HAND_JOINT_THUMB_TIP] - joints->z[HAND_JOINT_INDEX_TIP];
+        float pinchDist = sqrtf(dx * dx + dy * dy + dz * dz);
         
         // Pinch threshold: ~2cm when touching, ~8cm when open
         const float PINCH_CLOSE = 0.02f;
@@ -128,61 +339,45 @@ static void DetectGestures(VRHand* hand) {
         
         hand->pinchStrength = 1.0f - ((pinchDist - PINCH_CLOSE) / (PINCH_OPEN - PINCH_CLOSE));
         hand->pinchStrength = fmaxf(0.0f, fminf(1.0f, hand->pinchStrength));
-        hand->isPinching = hand->pinchStrength > 0.8f;
+        hand->isPinching = hand->pinchStrength > (hand->isPinching ? 0.6f : 0.8f);
     } else {
         hand->isPinching = false;
         hand->pinchStrength = 0.0f;
     }
     
-    // Fist detection - all fingertips close to palm
-    if (palm->isValid && indexTip->isValid && middleTip->isValid && 
-        ringTip->isValid && littleTip->isValid) {
-        float indexDist = Vector3Len(Vector3Sub(indexTip->position, palm->position));
-        float middleDist = Vector3Len(Vector3Sub(middleTip->position, palm->position));
-        float ringDist = Vector3Len(Vector3Sub(ringTip->position, palm->position));
-        float littleDist = Vector3Len(Vector3Sub(littleTip->position, palm->position));
+    // Fist, pointing and open hand all compare fingertip-to-palm distances
+    const uint32_t fingerJoints = JOINT_BIT(HAND_JOINT_PALM) | JOINT_BIT(HAND_JOINT_INDEX_TIP) |
+        JOINT_BIT(HAND_JOINT_MIDDLE_TIP) | JOINT_BIT(HAND_JOINT_RING_TIP) | JOINT_BIT(HAND_JOINT_LITTLE_TIP);
+    if ((valid & fingerJoints) == fingerJoints) {
+        float indexDist2 = palmDist2[HAND_JOINT_INDEX_TIP];
+        float middleDist2 = palmDist2[HAND_JOINT_MIDDLE_TIP];
+        float ringDist2 = palmDist2[HAND_JOINT_RING_TIP];
+        float littleDist2 = palmDist2[HAND_JOINT_LITTLE_TIP];
+        float nearest2 = fminf(fminf(indexDist2, middleDist2), fminf(ringDist2, littleDist2));
+        float farthest2 = fmaxf(fmaxf(indexDist2, middleDist2), fmaxf(ringDist2, littleDist2));
         
-        const float FIST_THRESHOLD = 0.05f;  // 5cm
-        hand->isFist = (indexDist < FIST_THRESHOLD && middleDist < FIST_THRESHOLD &&
-                        ringDist < FIST_THRESHOLD && littleDist < FIST_THRESHOLD);
-    } else {
-        hand->isFist = false;
-    }
-    
-    // Pointing detection - index extended, others curled
-    if (palm->isValid && indexTip->isValid && middleTip->isValid) {
-        float indexDist = Vector3Len(Vector3Sub(indexTip->position, palm->position));
-        float middleDist = Vector3Len(Vector3Sub(middleTip->position, palm->position));
-        float ringDist = Vector3Len(Vector3Sub(ringTip->position, palm->position));
-        float littleDist = Vector3Len(Vector3Sub(littleTip->position, palm->position));
+        // Fist - all fingertips within 5cm of the palm (6.5cm to leave)
+        float fist = hand->isFist ? 0.065f : 0.05f;
+        hand->isFist = farthest2 < fist * fist;
         
-        const float EXTENDED_THRESHOLD = 0.10f;  // 10cm
-        const float CURLED_THRESHOLD = 0.06f;    // 6cm
+        // Pointing - index extended past 10cm, middle and ring curled within 6cm
+        float extended = hand->isPointing ? 0.085f : 0.10f;
+        float curled = hand->isPointing ? 0.07f : 0.06f;
+        hand->isPointing = indexDist2 > extended * extended &&
+            middleDist2 < curled * curled && ringDist2 < curled * curled;
         
-        hand->isPointing = (indexDist > EXTENDED_THRESHOLD && 
-                           middleDist < CURLED_THRESHOLD &&
-                           ringDist < CURLED_THRESHOLD);
+        // Open hand - all fingertips beyond 8cm (6.5cm to leave)
+        float open = hand->isOpen ? 0.065f : 0.08f;
+        hand->isOpen = nearest2 > open * open;
     } else {
+        hand->isFist = false;
         hand->isPointing = false;
-    }
-    
-    // Open hand detection - all fingers extended
-    if (palm->isValid && indexTip->isValid && middleTip->isValid &&
-        ringTip->isValid && littleTip->isValid) {
-        float indexDist = Vector3Len(Vector3Sub(indexTip->position, palm->position));
-        float middleDist = Vector3Len(Vector3Sub(middleTip->position, palm->position));
-        float ringDist = Vector3Len(Vector3Sub(ringTip->position, palm->position));
-        float littleDist = Vector3Len(Vector3Sub(littleTip->position, palm->position));
-        
-        const float EXTENDED_THRESHOLD = 0.08f;
-        hand->isOpen = (indexDist > EXTENDED_THRESHOLD && middleDist > EXTENDED_THRESHOLD &&
-                       ringDist > EXTENDED_THRESHOLD && littleDist > EXTENDED_THRESHOLD);
-    } else {
         hand->isOpen = false;
     }
     
     // Palm direction/normal (from orientation)
-    if (palm->isValid) {
+    if (valid & JOINT_BIT(HAND_JOINT_PALM)) {
+        VRHandJoint* palm = &hand->joints[HAND_JOINT_PALM];
         hand->palmPosition = palm->position;
         hand->palmOrientation = palm->orientation;
         
@@ -203,6 +398,239 @@ static void DetectGestures(VRHand* hand) {
     }
 }
 
+// =============================================================================
+// Gesture Engine (joint history and gesture events)
+// =============================================================================
+
+// Motion gesture tuning (meters, seconds, meters per second)
+#define SWIPE_WINDOW 0.25f          // Palm stroke must happen within this time
+#define SWIPE_DISTANCE 0.15f
+#define SWIPE_SPEED 0.8f            // Average over the stroke
+#define SWIPE_MIN_SPEED 0.5f        // Palm still moving when the swipe is reported
+#define FLICK_SPEED 1.5f            // Index tip relative to the palm
+#define FLICK_MAX_PALM_SPEED 0.5f
+#define TAP_WINDOW 0.3f             // Jab and return within this time
+#define TAP_SPEED 0.35f             // Index tip relative to the palm, on the way out
+#define TAP_RETURN_SPEED 0.15f      // Back along the jab direction
+#define TAP_MAX_OFFSET 0.02f        // Tip ends up this close to where it started
+#define TAP_MAX_PALM_SPEED 0.3f
+#define PINCH_DRAG_DISTANCE 0.02f   // Pinch point travel before a drag starts
+#define MOTION_GESTURE_COOLDOWN 0.35f
+
+static unsigned int enabledGestures = HAND_GESTURE_ALL;
+
+// Ring entry at the given age (0 = newest)
+static const HandHistoryFrame* HistoryAt(const HandGestureState* state, int age) {
+    return &state->history[(state->head - age + HAND_HISTORY_FRAMES) % HAND_HISTORY_FRAMES];
+}
+
+static Vector3 HistoryPosition(const HandHistoryFrame* frame, int joint) {
+    return (Vector3){frame->x[joint], frame->y[joint], frame->z[joint]};
+}
+
+static Vector3 HistoryVelocity(const HandHistoryFrame* frame, int joint) {
+    return (Vector3){frame->vx[joint], frame->vy[joint], frame->vz[joint]};
+}
+
+static float Vector3DotProduct(Vector3 a, Vector3 b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+static void EmitGesture(int hand, HandGesture gesture, Vector3 position, Vector3 direction, float magnitude) {
+    if (!(enabledGestures & gesture)) return;
+    
+    htState.gestures[hand].detected |= gesture;
+    if (htState.eventCount >= HAND_GESTURE_QUEUE_SIZE) return;
+    htState.events[htState.eventCount++] = (HandGestureEvent){
+        .gesture = gesture,
+        .hand = (ControllerHand)hand,
+        .position = position,
+        .direction = direction,
+        .magnitude = magnitude
+    };
+}
+
+// Append this frame's joints to the history. Runtime joint velocities are
+// used where valid; otherwise (playback, or a runtime without velocities)
+// they are differenced against the previous frame
+static void PushHandHistory(int hand, const XrHandJointVelocityEXT* velocities, float dt) {
+    HandGestureState* state = &htState.gestures[hand];
+    const VRHandJoints* joints = &htState.packed[hand];
+    const HandHistoryFrame* previous = (state->count > 0) ? HistoryAt(state, 0) : NULL;
+    
+    state->head = (state->head + 1) % HAND_HISTORY_FRAMES;
+    if (state->count < HAND_HISTORY_FRAMES) state->count++;
+    
+    HandHistoryFrame* frame = &state->history[state->head];
+    frame->time = htState.gestureTime;
+    frame->validMask = joints->validMask;
+    memcpy(frame->x, joints->x, sizeof(frame->x));
+    memcpy(frame->y, joints->y, sizeof(frame->y));
+    memcpy(frame->z, joints->z, sizeof(frame->z));
+    
+    for (int j = 0; j < HAND_JOINT_COUNT; j++) {
+        if (velocities && (velocities[j].velocityFlags & XR_SPACE_VELOCITY_LINEAR_VALID_BIT)) {
+            frame->vx[j] = velocities[j].linearVelocity.x;
+            frame->vy[j] = velocities[j].linearVelocity.y;
+            frame->vz[j] = velocities[j].linearVelocity.z;
+        } else if (previous && dt > 0.0f && (previous->validMask & frame->validMask & JOINT_BIT(j))) {
+            frame->vx[j] = (frame->x[j] - previous->x[j]) / dt;
+            frame->vy[j] = (frame->y[j] - previous->y[j]) / dt;
+            frame->vz[j] = (frame->z[j] - previous->z[j]) / dt;
+        } else {
+            frame->vx[j] = frame->vy[j] = frame->vz[j] = 0.0f;
+        }
+    }
+}
+
+// Pose gestures fire on the frame the pose is entered (pinch also on release)
+static void EmitPoseGestures(int hand, const VRHand* before) {
+    const VRHand* now = &htState.hands[hand];
+    Vector3 palm = GetHandJointPosition((ControllerHand)hand, HAND_JOINT_PALM);
+    Vector3 none = {0, 0, 0};
+    
+    if (now->isPinching != before->isPinching) {
+        EmitGesture(hand, now->isPinching ? HAND_GESTURE_PINCH : HAND_GESTURE_PINCH_RELEASE,
+            GetPinchPosition((ControllerHand)hand), none, now->pinchStrength);
+    }
+    if (now->isFist && !before->isFist) EmitGesture(hand, HAND_GESTURE_FIST, palm, none, 0.0f);
+    if (now->isPointing && !before->isPointing) {
+        EmitGesture(hand, HAND_GESTURE_POINT, GetIndexTip((ControllerHand)hand),
+            GetPointingDirection((ControllerHand)hand), 0.0f);
+    }
+    if (now->isOpen && !before->isOpen) EmitGesture(hand, HAND_GESTURE_OPEN, palm, now->palmNormal, 0.0f);
+}
+
+// Once the pinch point has moved far enough, report its motion every frame
+// until the pinch is released
+static void DetectPinchDrag(int hand) {
+    HandGestureState* state = &htState.gestures[hand];
+    if (!htState.hands[hand].isPinching) {
+        state->dragging = false;
+        state->pinchHeld = false;
+        return;
+    }
+    
+    Vector3 pinch = GetPinchPosition((ControllerHand)hand);
+    if (!state->pinchHeld) {
+        state->pinchHeld = true;
+        state->pinchStart = pinch;
+        state->pinchLast = pinch;
+        return;
+    }
+    
+    if (!state->dragging) {
+        if (Vector3Len(Vector3Sub(pinch, state->pinchStart)) < PINCH_DRAG_DISTANCE) return;
+        state->dragging = true;
+        state->pinchLast = state->pinchStart;
+    }
+    
+    Vector3 delta = Vector3Sub(pinch, state->pinchLast);
+    state->pinchLast = pinch;
+    EmitGesture(hand, HAND_GESTURE_PINCH_DRAG, pinch, Vector3Norm(delta), Vector3Len(delta));
+}
+
+// Swipe, flick and tap from the joint history. At most one motion gesture
+// fires per cooldown, so the rebound of a flick is not also a tap
+static void DetectMotionGestures(int hand) {
+    const unsigned int motionGestures = HAND_GESTURE_SWIPE | HAND_GESTURE_FLICK | HAND_GESTURE_TAP;
+    HandGestureState* state = &htState.gestures[hand];
+    if (!(enabledGestures & motionGestures) || state->count < 2) return;
+    if (htState.gestureTime < state->motionCooldown) return;
+    
+    const uint32_t needed = JOINT_BIT(HAND_JOINT_PALM) | JOINT_BIT(HAND_JOINT_INDEX_TIP);
+    const HandHistoryFrame* now = HistoryAt(state, 0);
+    if ((now->validMask & needed) != needed) return;
+    
+    Vector3 palm = HistoryPosition(now, HAND_JOINT_PALM);
+    Vector3 tip = HistoryPosition(now, HAND_JOINT_INDEX_TIP);
+    Vector3 palmVelocity = HistoryVelocity(now, HAND_JOINT_PALM);
+    Vector3 tipVelocity = Vector3Sub(HistoryVelocity(now, HAND_JOINT_INDEX_TIP), palmVelocity);
+    float palmSpeed = Vector3Len(palmVelocity);
+    float tipSpeed = Vector3Len(tipVelocity);
+    
+    // Swipe: the palm covered enough ground, fast, within the window
+    if ((enabledGestures & HAND_GESTURE_SWIPE) && palmSpeed > SWIPE_MIN_SPEED) {
+        const HandHistoryFrame* start = NULL;
+        for (int age = 1; age < state->count; age++) {
+            const HandHistoryFrame* frame = HistoryAt(state, age);
+            if (now->time - frame->time > SWIPE_WINDOW) break;
+            if (frame->validMask & JOINT_BIT(HAND_JOINT_PALM)) start = frame;
+        }
+        if (start != NULL) {
+            Vector3 stroke = Vector3Sub(palm, HistoryPosition(start, HAND_JOINT_PALM));
+            float distance = Vector3Len(stroke);
+            float duration = now->time - start->time;
+            if (duration > 0.0f && distance > SWIPE_DISTANCE && distance / duration > SWIPE_SPEED) {
+                EmitGesture(hand, HAND_GESTURE_SWIPE, palm, Vector3Norm(stroke), distance / duration);
+                state->motionCooldown = htState.gestureTime + MOTION_GESTURE_COOLDOWN;
+                return;
+            }
+        }
+    }
+    
+    // Flick: the index tip snaps away while the palm holds still
+    if ((enabledGestures & HAND_GESTURE_FLICK) && tipSpeed > FLICK_SPEED && palmSpeed < FLICK_MAX_PALM_SPEED) {
+        EmitGesture(hand, HAND_GESTURE_FLICK, tip, Vector3Norm(tipVelocity), tipSpeed);
+        state->motionCooldown = htState.gestureTime + MOTION_GESTURE_COOLDOWN;
+        return;
+    }
+    
+    // Tap: within the window the tip jabbed out, and is now coming back to
+    // about where it started
+    if ((enabledGestures & HAND_GESTURE_TAP) && palmSpeed < TAP_MAX_PALM_SPEED) {
+        Vector3 tipOffset = Vector3Sub(tip, palm);
+        const HandHistoryFrame* jab = NULL;
+        Vector3 jabVelocity = {0, 0, 0};
+        float jabSpeed = 0.0f;
+        const HandHistoryFrame* start = NULL;
+        
+        for (int age = 1; age < state->count; age++) {
+            const HandHistoryFrame* frame = HistoryAt(state, age);
+            if (now->time - frame->time > TAP_WINDOW) break;
+            if ((frame->validMask & needed) != needed) continue;
+            start = frame;
+            
+            Vector3 velocity = Vector3Sub(HistoryVelocity(frame, HAND_JOINT_INDEX_TIP),
+                HistoryVelocity(frame, HAND_JOINT_PALM));
+            float speed = Vector3Len(velocity);
+            if (speed > jabSpeed) {
+                jab = frame;
+                jabVelocity = velocity;
+                jabSpeed = speed;
+            }
+        }
+        
+        if (jab != NULL && jabSpeed > TAP_SPEED) {
+            Vector3 jabDirection = Vector3Norm(jabVelocity);
+            Vector3 startOffset = Vector3Sub(HistoryPosition(start, HAND_JOINT_INDEX_TIP),
+                HistoryPosition(start, HAND_JOINT_PALM));
+            bool returning = Vector3DotProduct(tipVelocity, jabDirection) < -TAP_RETURN_SPEED;
+            bool nearStart = Vector3Len(Vector3Sub(tipOffset, startOffset)) < TAP_MAX_OFFSET;
+            if (returning && nearStart) {
+                EmitGesture(hand, HAND_GESTURE_TAP, tip, jabDirection, jabSpeed);
+                state->motionCooldown = htState.gestureTime + MOTION_GESTURE_COOLDOWN;
+            }
+        }
+    }
+}
+
+// Derive the pose flags and gesture events for one hand, once its joints
+// (live or replayed) are in place
+static void UpdateHandGestures(int hand, const XrHandJointVelocityEXT* velocities, float dt) {
+    VRHand before = htState.hands[hand];
+    
+    PackHandJoints(hand);
+    DetectGestures(hand);
+    PushHandHistory(hand, velocities, dt);
+    
+    EmitPoseGestures(hand, &before);
+    DetectPinchDrag(hand);
+    if (htState.hands[hand].isTracking) {
+        DetectMotionGestures(hand);
+    }
+}
+
 // =============================================================================
 // Initialization
 // =============================================================================
@@ -364,11 +792,36 @@ void ShutdownHandTracking(void) {
 // =============================================================================
 
 void UpdateHandTracking(void) {
+    // Events and detected gestures only cover the latest update
+    htState.eventCount = 0;
+    htState.eventRead = 0;
+    htState.gestures[0].detected = 0;
+    htState.gestures[1].detected = 0;
+    
     if (!htState.initialized || !IsVRSessionRunning()) {
         // Clear tracking state
         for (int i = 0; i < 2; i++) {
             htState.hands[i].isTracking = false;
             htState.hands[i].isActive = false;
+            htState.packed[i].validMask = 0;
+        }
+        return;
+    }
+    
+    float dt = GetFrameTime();
+    htState.gestureTime += dt;
+    
+    // Recorded (unfiltered) joints replace the tracker during playback;
+    // filtering and gestures are re-derived
+    const XrHandJointVelocityEXT* velocities[2] = {NULL, NULL};
+    bool replayed[2];
+    for (int hand = 0; hand < 2; hand++) {
+        replayed[hand] = PlaybackHand(hand, &htState.hands[hand]);
+    }
+    if (replayed[0] || replayed[1]) {
+        if (filterEnabled) FilterHandJoints(velocities, dt);
+        for (int hand = 0; hand < 2; hand++) {
+            if (replayed[hand]) UpdateHandGestures(hand, NULL, dt);
         }
         return;
     }
@@ -384,7 +837,7 @@ void UpdateHandTracking(void) {
         if (htState.handTracker[hand] == XR_NULL_HANDLE) continue;
         
         // Set up velocity locations
-        XrHandJointVelocitiesEXT velocities = {
+        XrHandJointVelocitiesEXT jointVelocities = {
             .type = XR_TYPE_HAND_JOINT_VELOCITIES_EXT,
             .next = NULL,
             .jointCount = XR_HAND_JOINT_COUNT_EXT,
@@ -394,7 +847,7 @@ void UpdateHandTracking(void) {
         // Set up joint locations  
         XrHandJointLocationsEXT locations = {
             .type = XR_TYPE_HAND_JOINT_LOCATIONS_EXT,
-            .next = &velocities,
+            .next = &jointVelocities,
             .jointCount = XR_HAND_JOINT_COUNT_EXT,
             .jointLocations = htState.jointLocations[hand]
         };
@@ -433,9 +886,7 @@ void UpdateHandTracking(void) {
                 dst->radius = src->radius;
             }
             
-            // Detect gestures
-            DetectGestures(&htState.hands[hand]);
-            
+            velocities[hand] = htState.jointVelocities[hand];
         } else {
             htState.hands[hand].isTracking = false;
             
@@ -443,15 +894,33 @@ void UpdateHandTracking(void) {
             for (int j = 0; j < HAND_JOINT_COUNT; j++) {
                 htState.hands[hand].joints[j].isValid = false;
             }
-            
-            // Clear gestures
-            htState.hands[hand].isPinching = false;
-            htState.hands[hand].pinchStrength = 0.0f;
-            htState.hands[hand].isFist = false;
-            htState.hands[hand].isPointing = false;
-            htState.hands[hand].isOpen = false;
         }
+        
+        // Recordings keep the raw poses, so playback can be filtered differently
+        RecordHand(hand, &htState.hands[hand]);
     }
+    
+    if (filterEnabled) FilterHandJoints(velocities, dt);
+    
+    // Detect gestures (a lost hand clears its flags and ends any pinch)
+    for (int hand = 0; hand < 2; hand++) {
+        if (htState.handTracker[hand] == XR_NULL_HANDLE) continue;
+        UpdateHandGestures(hand, velocities[hand], dt);
+    }
+}
+
+void SetHandFilterEnabled(bool enabled) {
+    if (enabled && !filterEnabled) {
+        // Start from the next raw poses rather than stale filter state
+        htState.filter.primed[0] = 0;
+        htState.filter.primed[1] = 0;
+    }
+    filterEnabled = enabled;
+}
+
+void SetHandFilterParams(float minCutoff, float beta) {
+    filterMinCutoff = (minCutoff > 0.01f) ? minCutoff : 0.01f;
+    filterBeta = (beta > 0.0f) ? beta : 0.0f;
 }
 
 // =============================================================================
@@ -474,6 +943,31 @@ VRHand GetRightHand(void) {
     return htState.hands[1];
 }
 
+const VRHand* GetHandRef(ControllerHand hand) {
+    if (hand < 0 || hand > 1) return &emptyHand;
+    return &htState.hands[hand];
+}
+
+const VRHandJoints* GetHandJoints(ControllerHand hand) {
+    if (hand < 0 || hand > 1) return &emptyJoints;
+    return &htState.packed[hand];
+}
+
+void SetHandGesturesEnabled(unsigned int flags) {
+    enabledGestures = flags;
+}
+
+bool PollHandGesture(HandGestureEvent* event) {
+    if (event == NULL || htState.eventRead >= htState.eventCount) return false;
+    *event = htState.events[htState.eventRead++];
+    return true;
+}
+
+bool IsHandGestureDetected(ControllerHand hand, HandGesture gesture) {
+    if (hand < 0 || hand > 1) return false;
+    return (htState.gestures[hand].detected & gesture) != 0;
+}
+
 bool IsHandTracked(ControllerHand hand) {
     if (hand < 0 || hand > 1) return false;
     return htState.hands[hand].isTracking;
@@ -590,74 +1084,28 @@ bool IsHandOpen(ControllerHand hand) {
 // Visualization
 // =============================================================================
 
-// Joint connections for skeleton drawing
-static const int skeletonConnections[][2] = {
-    // Thumb
-    {HAND_JOINT_WRIST, HAND_JOINT_THUMB_METACARPAL},
-    {HAND_JOINT_THUMB_METACARPAL, HAND_JOINT_THUMB_PROXIMAL},
-    {HAND_JOINT_THUMB_PROXIMAL, HAND_JOINT_THUMB_DISTAL},
-    {HAND_JOINT_THUMB_DISTAL, HAND_JOINT_THUMB_TIP},
-    // Index
-    {HAND_JOINT_WRIST, HAND_JOINT_INDEX_METACARPAL},
-    {HAND_JOINT_INDEX_METACARPAL, HAND_JOINT_INDEX_PROXIMAL},
-    {HAND_JOINT_INDEX_PROXIMAL, HAND_JOINT_INDEX_INTERMEDIATE},
-    {HAND_JOINT_INDEX_INTERMEDIATE, HAND_JOINT_INDEX_DISTAL},
-    {HAND_JOINT_INDEX_DISTAL, HAND_JOINT_INDEX_TIP},
-    // Middle
-    {HAND_JOINT_WRIST, HAND_JOINT_MIDDLE_METACARPAL},
-    {HAND_JOINT_MIDDLE_METACARPAL, HAND_JOINT_MIDDLE_PROXIMAL},
-    {HAND_JOINT_MIDDLE_PROXIMAL, HAND_JOINT_MIDDLE_INTERMEDIATE},
-    {HAND_JOINT_MIDDLE_INTERMEDIATE, HAND_JOINT_MIDDLE_DISTAL},
-    {HAND_JOINT_MIDDLE_DISTAL, HAND_JOINT_MIDDLE_TIP},
-    // Ring
-    {HAND_JOINT_WRIST, HAND_JOINT_RING_METACARPAL},
-    {HAND_JOINT_RING_METACARPAL, HAND_JOINT_RING_PROXIMAL},
-    {HAND_JOINT_RING_PROXIMAL, HAND_JOINT_RING_INTERMEDIATE},
-    {HAND_JOINT_RING_INTERMEDIATE, HAND_JOINT_RING_DISTAL},
-    {HAND_JOINT_RING_DISTAL, HAND_JOINT_RING_TIP},
-    // Little
-    {HAND_JOINT_WRIST, HAND_JOINT_LITTLE_METACARPAL},
-    {HAND_JOINT_LITTLE_METACARPAL, HAND_JOINT_LITTLE_PROXIMAL},
-    {HAND_JOINT_LITTLE_PROXIMAL, HAND_JOINT_LITTLE_INTERMEDIATE},
-    {HAND_JOINT_LITTLE_INTERMEDIATE, HAND_JOINT_LITTLE_DISTAL},
-    {HAND_JOINT_LITTLE_DISTAL, HAND_JOINT_LITTLE_TIP},
-    // Palm connections
-    {HAND_JOINT_INDEX_METACARPAL, HAND_JOINT_MIDDLE_METACARPAL},
-    {HAND_JOINT_MIDDLE_METACARPAL, HAND_JOINT_RING_METACARPAL},
-    {HAND_JOINT_RING_METACARPAL, HAND_JOINT_LITTLE_METACARPAL},
-};
-
-static const int skeletonConnectionCount = sizeof(skeletonConnections) / sizeof(skeletonConnections[0]);
+// Both go to the hand renderer in realitylib_vr.c, which draws every hand's
+// joints and bones with two instanced draws in total
 
 void DrawHandSkeleton(ControllerHand hand, Color color) {
     if (hand < 0 || hand > 1) return;
     if (!htState.hands[hand].isTracking) return;
     
-    VRHand* h = &htState.hands[hand];
-    
-    for (int i = 0; i < skeletonConnectionCount; i++) {
-        int j1 = skeletonConnections[i][0];
-        int j2 = skeletonConnections[i][1];
-        
-        if (h->joints[j1].isValid && h->joints[j2].isValid) {
-            DrawVRLine3D(h->joints[j1].position, h->joints[j2].position, color);
-        }
-    }
+    RecordHandBones(hand, &htState.packed[hand], color);
 }
 
 void DrawHandJoints(ControllerHand hand, Color color) {
     if (hand < 0 || hand > 1) return;
     if (!htState.hands[hand].isTracking) return;
     
-    VRHand* h = &htState.hands[hand];
+    RecordHandJoints(hand, &htState.packed[hand], color);
+}
+
+void DrawHandPose(ControllerHand hand, const VRHandJoints* joints, Color color) {
+    if (hand < 0 || hand > 1 || joints == NULL) return;
     
-    for (int j = 0; j < HAND_JOINT_COUNT; j++) {
-        if (h->joints[j].isValid) {
-            float radius = h->joints[j].radius;
-            if (radius < 0.005f) radius = 0.005f;  // Minimum visible size
-            DrawVRSphere(h->joints[j].position, radius, color);
-        }
-    }
+    RecordHandJoints(hand, joints, color);
+    RecordHandBones(hand, joints, color);
 }
 
 // =============================================================================
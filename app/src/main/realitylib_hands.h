@@ -15,6 +15,7 @@
 #define REALITYLIB_HANDS_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "realitylib_vr.h"
 
 #ifdef __cplusplus
@@ -93,6 +94,22 @@ typedef struct {
     bool isOpen;               // All fingers extended (open hand)
 } VRHand;
 
+// Joint arrays in VRHandJoints are padded to a multiple of 4 floats
+#define HAND_JOINT_SOA_STRIDE 28
+
+/**
+ * Packed joint snapshot (structure of arrays), rebuilt by UpdateHandTracking()
+ * Joint j is at (x[j], y[j], z[j]); every array is 16-byte aligned and padded
+ * with zeros, so batch loops can load four joints at a time
+ */
+typedef struct {
+    float x[HAND_JOINT_SOA_STRIDE];       // World-space positions
+    float y[HAND_JOINT_SOA_STRIDE];
+    float z[HAND_JOINT_SOA_STRIDE];
+    float radius[HAND_JOINT_SOA_STRIDE];  // Joint radii in meters
+    uint32_t validMask;                   // Bit j set if joint j is valid (0 while not tracking)
+} __attribute__((aligned(16))) VRHandJoints;
+
 // =============================================================================
 // Initialization Functions
 // =============================================================================
@@ -133,6 +150,22 @@ void ShutdownHandTracking(void);
  */
 void UpdateHandTracking(void);
 
+/**
+ * Enable or disable joint filtering (default off)
+ * Joint positions go through a One-Euro filter before gestures are detected:
+ * heavy smoothing while a hand is still, little while it moves, with the
+ * filter's lag made up from the joint velocities. Orientations are not filtered
+ * @param enabled true to filter, false for raw runtime poses
+ */
+void SetHandFilterEnabled(bool enabled);
+
+/**
+ * Tune the joint filter
+ * @param minCutoff Cutoff frequency (Hz) for a still hand; lower = smoother (default 1.5)
+ * @param beta Cutoff increase per m/s of joint speed; higher = less lag (default 4.0)
+ */
+void SetHandFilterParams(float minCutoff, float beta);
+
 // =============================================================================
 // Hand Data Access
 // =============================================================================
@@ -156,6 +189,22 @@ VRHand GetLeftHand(void);
  */
 VRHand GetRightHand(void);
 
+/**
+ * Get hand tracking data without copying it
+ * The pointer stays valid for the whole session; its contents change on
+ * the next UpdateHandTracking()
+ * @param hand Which hand (CONTROLLER_LEFT or CONTROLLER_RIGHT)
+ * @return Read-only hand data (an empty hand for an invalid index)
+ */
+const VRHand* GetHandRef(ControllerHand hand);
+
+/**
+ * Get this frame's packed joint snapshot
+ * @param hand Which hand
+ * @return Read-only joint arrays (an empty snapshot for an invalid index)
+ */
+const VRHandJoints* GetHandJoints(ControllerHand hand);
+
 /**
  * Check if a specific hand is being tracked
  * @param hand Which hand
@@ -267,14 +316,72 @@ Vector3 GetPointingDirection(ControllerHand hand);
  */
 bool IsHandOpen(ControllerHand hand);
 
+// =============================================================================
+// Gesture Events
+// =============================================================================
+
+/**
+ * Gestures reported by UpdateHandTracking() (raylib-style flags)
+ * Pose gestures fire on the frame the pose is entered; motion gestures are
+ * found in the last few frames of joint positions and velocities
+ */
+typedef enum {
+    HAND_GESTURE_NONE = 0,
+    HAND_GESTURE_PINCH = 1,             // Pinch closed (position = pinch point)
+    HAND_GESTURE_PINCH_RELEASE = 2,     // Pinch opened or tracking lost
+    HAND_GESTURE_FIST = 4,
+    HAND_GESTURE_POINT = 8,             // direction = pointing direction
+    HAND_GESTURE_OPEN = 16,             // direction = palm normal
+    HAND_GESTURE_SWIPE = 32,            // Fast palm stroke; direction = stroke, magnitude = m/s
+    HAND_GESTURE_TAP = 64,              // Index tip jab and return; direction = jab
+    HAND_GESTURE_FLICK = 128,           // Index tip snapped away from a still palm
+    HAND_GESTURE_PINCH_DRAG = 256,      // Every frame a pinch moves after passing 2cm; magnitude = meters moved
+    HAND_GESTURE_ALL = 511
+} HandGesture;
+
+/**
+ * One detected gesture
+ */
+typedef struct {
+    HandGesture gesture;
+    ControllerHand hand;
+    Vector3 position;       // Where it happened (pinch point, palm or index tip)
+    Vector3 direction;      // Unit direction, zero for poses without one
+    float magnitude;        // Speed in m/s, drag distance in m, or pinch strength
+} HandGestureEvent;
+
+/**
+ * Choose which gestures are detected (default HAND_GESTURE_ALL)
+ * @param flags Combination of HandGesture values
+ */
+void SetHandGesturesEnabled(unsigned int flags);
+
+/**
+ * Take the next gesture event of the latest UpdateHandTracking()
+ * Events not polled before the next update are dropped
+ * @param event Receives the event
+ * @return true if an event was returned
+ */
+bool PollHandGesture(HandGestureEvent* event);
+
+/**
+ * Check if a gesture was detected on a hand in the latest update
+ * @param hand Which hand
+ * @param gesture One HandGesture value
+ * @return true if detected this frame
+ */
+bool IsHandGestureDetected(ControllerHand hand, HandGesture gesture);
+
 // =============================================================================
 // Visualization Helpers
 // =============================================================================
 
 /**
  * Draw hand skeleton visualization
+ * Both hands' skeletons and joints render in two instanced draws, whatever
+ * the number of valid joints
  * @param hand Which hand
- * @param color Color for the skeleton lines
+ * @param color Color for the bone capsules
  */
 void DrawHandSkeleton(ControllerHand hand, Color color);
 
@@ -285,6 +392,16 @@ void DrawHandSkeleton(ControllerHand hand, Color color);
  */
 void DrawHandJoints(ControllerHand hand, Color color);
 
+/**
+ * Draw joints and bones from caller-supplied joint data (e.g. a hand posed
+ * from controller input) through the same instanced path
+ * Replaces what DrawHandJoints/DrawHandSkeleton drew for that hand this frame
+ * @param hand Which hand slot to draw into
+ * @param joints Joint positions, radii and valid mask
+ * @param color Color for joints and bones
+ */
+void DrawHandPose(ControllerHand hand, const VRHandJoints* joints, Color color);
+
 // =============================================================================
 // Utility Functions
 // =============================================================================
@@ -1,13 +1,18 @@
 /**
  * RealityLib Text - 3x5 Pixel Font Rendering for VR
  *
- * Implementation of bitmap text rendering using DrawVRCube as pixel output.
+ * Each character is one textured quad from a signed distance field atlas of
+ * the 3x5 font; the glyph renderer in realitylib_vr.c draws all of a frame's
+ * quads in one instanced draw.
  */
 
 #include "realitylib_text.h"
 #include <math.h>
 #include <string.h>
 
+// Glyph renderer hook (realitylib_vr.c)
+extern void RecordGlyph(Vector3 center, Vector3 halfRight, Vector3 halfUp, const float uv[4], Color color);
+
 // =============================================================================
 // Font Data - 3x5 Bitmap
 // =============================================================================
@@ -47,11 +52,83 @@ static const unsigned char fontAlpha[26][5] = {
     {7,1,2,4,7}  // Z
 };
 
-static const unsigned char* GetFontBitmap(char ch) {
-    if (ch >= '0' && ch <= '9') return fontDigits[ch - '0'];
-    if (ch >= 'A' && ch <= 'Z') return fontAlpha[ch - 'A'];
-    if (ch >= 'a' && ch <= 'z') return fontAlpha[ch - 'a'];
-    return NULL;
+// Atlas slot of a character: digits first, then letters (-1 if not in the font)
+static int GetGlyphIndex(char ch) {
+    if (ch >= '0' && ch <= '9') return ch - '0';
+    if (ch >= 'A' && ch <= 'Z') return 10 + (ch - 'A');
+    if (ch >= 'a' && ch <= 'z') return 10 + (ch - 'a');
+    return -1;
+}
+
+static const unsigned char* GetGlyphBitmap(int glyph) {
+    return (glyph < 10) ? fontDigits[glyph] : fontAlpha[glyph - 10];
+}
+
+// =============================================================================
+// Glyph Atlas - Signed Distance Field
+// =============================================================================
+
+// Distances are measured in pixel pitches (step = pixSize * 1.25). A lit
+// pixel is a 0.8 x 0.8 square centered on its grid point, as the cube text
+// used to be, and each cell keeps half a pitch of margin around the glyph
+#define GLYPH_COUNT 36
+#define GLYPH_ATLAS_COLUMNS 6
+#define GLYPH_TEXELS_PER_STEP 8
+#define GLYPH_CELL_STEPS_X 4
+#define GLYPH_CELL_STEPS_Y 6
+#define GLYPH_CELL_WIDTH (GLYPH_CELL_STEPS_X * GLYPH_TEXELS_PER_STEP)
+#define GLYPH_CELL_HEIGHT (GLYPH_CELL_STEPS_Y * GLYPH_TEXELS_PER_STEP)
+#define GLYPH_ATLAS_WIDTH (GLYPH_ATLAS_COLUMNS * GLYPH_CELL_WIDTH)
+#define GLYPH_ATLAS_HEIGHT (((GLYPH_COUNT + GLYPH_ATLAS_COLUMNS - 1) / GLYPH_ATLAS_COLUMNS) * GLYPH_CELL_HEIGHT)
+#define GLYPH_PIXEL_HALF 0.4f           // Half the lit square, in pitches
+#define GLYPH_SDF_SPREAD 0.5f           // Distance (pitches) from the edge to 0 or 255
+
+static unsigned char fontAtlas[GLYPH_ATLAS_HEIGHT][GLYPH_ATLAS_WIDTH];
+static bool fontAtlasBuilt = false;
+
+// Signed distance from (x, y) to the nearest lit pixel, negative inside.
+// The squares never touch, so the minimum over them is exact
+static float GlyphDistance(const unsigned char* bmp, float x, float y) {
+    float best = 1e9f;
+    for (int row = 0; row < 5; row++) {
+        for (int col = 0; col < 3; col++) {
+            if (!(bmp[row] & (4 >> col))) continue;
+            float dx = fabsf(x - col) - GLYPH_PIXEL_HALF;
+            float dy = fabsf(y - row) - GLYPH_PIXEL_HALF;
+            float ox = fmaxf(dx, 0.0f);
+            float oy = fmaxf(dy, 0.0f);
+            float d = sqrtf(ox * ox + oy * oy) + fminf(fmaxf(dx, dy), 0.0f);
+            if (d < best) best = d;
+        }
+    }
+    return best;
+}
+
+static void BuildFontAtlas(void) {
+    for (int glyph = 0; glyph < GLYPH_COUNT; glyph++) {
+        const unsigned char* bmp = GetGlyphBitmap(glyph);
+        int cellX = (glyph % GLYPH_ATLAS_COLUMNS) * GLYPH_CELL_WIDTH;
+        int cellY = (glyph / GLYPH_ATLAS_COLUMNS) * GLYPH_CELL_HEIGHT;
+        for (int ty = 0; ty < GLYPH_CELL_HEIGHT; ty++) {
+            for (int tx = 0; tx < GLYPH_CELL_WIDTH; tx++) {
+                // Texel center in pitches, with pixel (0, 0) at the origin and rows going down
+                float x = (tx + 0.5f) / GLYPH_TEXELS_PER_STEP - 1.0f;
+                float y = (ty + 0.5f) / GLYPH_TEXELS_PER_STEP - 1.0f;
+                float value = 0.5f - GlyphDistance(bmp, x, y) * (0.5f / GLYPH_SDF_SPREAD);
+                value = fminf(fmaxf(value, 0.0f), 1.0f);
+                fontAtlas[cellY + ty][cellX + tx] = (unsigned char)(value * 255.0f + 0.5f);
+            }
+        }
+    }
+    fontAtlasBuilt = true;
+}
+
+// Glyph renderer hook (realitylib_vr.c): single-channel SDF, 0.5 on the edge
+const unsigned char* GetFontAtlas(int* width, int* height) {
+    if (!fontAtlasBuilt) BuildFontAtlas();
+    *width = GLYPH_ATLAS_WIDTH;
+    *height = GLYPH_ATLAS_HEIGHT;
+    return &fontAtlas[0][0];
 }
 
 // =============================================================================
@@ -60,25 +137,30 @@ static const unsigned char* GetFontBitmap(char ch) {
 
 void DrawPixelChar(char ch, Vector3 origin, float pixSize, Color color,
                    float faceAngle) {
-    const unsigned char* bmp = GetFontBitmap(ch);
-    if (!bmp || pixSize < 0.001f) return;
+    int glyph = GetGlyphIndex(ch);
+    if (glyph < 0 || pixSize < 0.001f) return;
     float step = pixSize * 1.25f;
     float cosA = cosf(faceAngle);
     float sinA = sinf(faceAngle);
-    for (int row = 0; row < 5; row++) {
-        unsigned char bits = bmp[row];
-        for (int col = 0; col < 3; col++) {
-            if (bits & (4 >> col)) {
-                float rx = col * step;
-                Vector3 p = Vector3Create(
-                    origin.x + rx * cosA,
-                    origin.y - row * step,
-                    origin.z + rx * sinA
-                );
-                DrawVRCube(p, pixSize, color);
-            }
-        }
-    }
+    
+    // The cell spans one pitch left of pixel column 0 to one right of
+    // column 2, and one pitch above row 0 to one below row 4
+    float cx = (GLYPH_CELL_STEPS_X * 0.5f - 1.0f) * step;
+    float cy = (GLYPH_CELL_STEPS_Y * 0.5f - 1.0f) * step;
+    float halfW = GLYPH_CELL_STEPS_X * 0.5f * step;
+    float halfH = GLYPH_CELL_STEPS_Y * 0.5f * step;
+    Vector3 center = Vector3Create(origin.x + cx * cosA, origin.y - cy, origin.z + cx * sinA);
+    
+    float u0 = (float)((glyph % GLYPH_ATLAS_COLUMNS) * GLYPH_CELL_WIDTH) / GLYPH_ATLAS_WIDTH;
+    float v0 = (float)((glyph / GLYPH_ATLAS_COLUMNS) * GLYPH_CELL_HEIGHT) / GLYPH_ATLAS_HEIGHT;
+    const float uv[4] = {
+        u0, v0,
+        u0 + (float)GLYPH_CELL_WIDTH / GLYPH_ATLAS_WIDTH,
+        v0 + (float)GLYPH_CELL_HEIGHT / GLYPH_ATLAS_HEIGHT
+    };
+    
+    RecordGlyph(center, Vector3Create(halfW * cosA, 0.0f, halfW * sinA),
+                Vector3Create(0.0f, halfH, 0.0f), uv, color);
 }
 
 float GetTextWidth(const char* text, float pixSize) {
@@ -1,8 +1,9 @@
 /**
  * RealityLib Text - 3x5 Pixel Font Rendering for VR
  *
- * Provides bitmap-based text rendering using small cubes as pixels.
- * Supports A-Z (case-insensitive), 0-9, and spaces.
+ * Provides bitmap-based text rendering: each character is one quad sampled
+ * from a signed distance field of the font, and a frame's text is drawn in
+ * one batched draw. Supports A-Z (case-insensitive), 0-9, and spaces.
  * All text is rendered facing a given angle for VR HUD positioning.
  */
 
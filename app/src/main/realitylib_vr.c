@@ -13,9 +13,12 @@
 #include <EGL/eglext.h>
 #include <GLES3/gl3.h>
 #include <GLES3/gl3ext.h>
+#include <stddef.h>
 #include <string.h>
 #include <stdlib.h>
 #include <math.h>
+#include <time.h>
+#include <pthread.h>
 #include <jni.h>
 
 // XR_USE_GRAPHICS_API_OPENGL_ES and XR_USE_PLATFORM_ANDROID are defined in CMakeLists.txt
@@ -28,12 +31,65 @@
 #define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
 
 #define MAX_VIEWS 2
+#define VR_IDLE_POLL_TIMEOUT_MS 100     // Looper wait while the session is not running
+#define VR_UNFOCUSED_UPDATE_INTERVAL 4  // App updates once every N frames while unfocused
+#define VR_MAX_FRAME_TIME 0.1f          // GetFrameTime() cap after stalls
+#define VR_DEFAULT_FRAME_TIME (1.0f / 72.0f)
+
+// Dynamic resolution: default scale range, and the share of the display
+// period the GPU may use before the scale drops
+#define VR_RESOLUTION_SCALE_MIN 0.6f
+#define VR_RESOLUTION_SCALE_MAX 1.0f
+#define VR_RESOLUTION_GPU_BUDGET 0.85f
 #define PI 3.14159265358979323846f
 
+// GL_OVR_multiview entry point (not exported by libGLESv3, loaded through EGL)
+#ifndef GL_OVR_multiview
+typedef void (GL_APIENTRYP PFNGLFRAMEBUFFERTEXTUREMULTIVIEWOVRPROC)(GLenum target, GLenum attachment,
+    GLuint texture, GLint level, GLint baseViewIndex, GLsizei numViews);
+#endif
+
+// Multisampled render-to-texture entry points (resolve on-tile, no blit)
+#ifndef GL_EXT_multisampled_render_to_texture
+#define GL_MAX_SAMPLES_EXT 0x9135
+typedef void (GL_APIENTRYP PFNGLFRAMEBUFFERTEXTURE2DMULTISAMPLEEXTPROC)(GLenum target, GLenum attachment,
+    GLenum textarget, GLuint texture, GLint level, GLsizei samples);
+typedef void (GL_APIENTRYP PFNGLRENDERBUFFERSTORAGEMULTISAMPLEEXTPROC)(GLenum target, GLsizei samples,
+    GLenum internalformat, GLsizei width, GLsizei height);
+#endif
+#ifndef GL_OVR_multiview_multisampled_render_to_texture
+typedef void (GL_APIENTRYP PFNGLFRAMEBUFFERTEXTUREMULTISAMPLEMULTIVIEWOVRPROC)(GLenum target, GLenum attachment,
+    GLuint texture, GLint level, GLsizei samples, GLint baseViewIndex, GLsizei numViews);
+#endif
+
+// GL_EXT_disjoint_timer_query tokens and the one entry point not in GLES 3.0 core
+#ifndef GL_EXT_disjoint_timer_query
+#define GL_TIME_ELAPSED_EXT 0x88BF
+#define GL_GPU_DISJOINT_EXT 0x8FBB
+typedef void (GL_APIENTRYP PFNGLGETQUERYOBJECTUI64VEXTPROC)(GLuint id, GLenum pname, GLuint64* params);
+#endif
+
 // =============================================================================
 // Global State
 // =============================================================================
 
+// Everything the render path needs from BeginVRMode for one frame. The app
+// thread fills vrState.frame; with the render thread running, the frame
+// being replayed is a copy taken when EndVRMode hands it over
+typedef struct {
+    XrTime displayTime;
+    bool shouldRender;              // Runtime will display this frame (XrFrameState)
+    bool cull;                      // False while unfocused frames re-render retained commands
+    XrView views[MAX_VIEWS];
+    float viewProj[MAX_VIEWS][16];  // Column-major view-projection per eye
+    Vector3 eyeWorldPosition[MAX_VIEWS];
+    float eyeFocalPixels[MAX_VIEWS];  // Projection scale at the recommended size, for mesh LOD selection
+    XrPosef spacePoses[VR_SPACE_COUNT];   // Poses the app placed attached draws with
+    bool spaceTracked[VR_SPACE_COUNT];    // False = draws in that space are not re-posed
+    VRFrameStats stats;             // Timing of this frame, committed after xrEndFrame
+    double frameStart;
+} RenderFrame;
+
 typedef struct {
     // Android
     struct android_app* app;
@@ -55,18 +111,43 @@ typedef struct {
     XrSpace leftHandSpace;
     XrSpace rightHandSpace;
     
-    // Swapchain
+    // Swapchain (one per eye, or a single 2-layer array in multiview mode)
     XrSwapchain swapchain[MAX_VIEWS];
     uint32_t swapchainLength[MAX_VIEWS];
+    uint32_t swapchainCount;
     XrSwapchainImageOpenGLESKHR* swapchainImages[MAX_VIEWS];
-    GLuint framebuffer[MAX_VIEWS];
+    GLuint* framebuffers[MAX_VIEWS];    // One per swapchain image, attachments fixed at creation
+    uint32_t imageWidth[MAX_VIEWS];     // Allocated size (the largest rect a frame can render)
+    uint32_t imageHeight[MAX_VIEWS];
     GLuint depthBuffer[MAX_VIEWS];
+    GLenum depthFormat;
+    GLenum depthAttachment;             // GL_DEPTH_STENCIL_ATTACHMENT unless depth-only
+    
+    // MSAA (FLAG_VR_MSAA_2X / FLAG_VR_MSAA_4X)
+    int msaaSamples;                    // 1 = off
+    bool msaaResolveBlit;               // No on-tile resolve: render to msaaFramebuffer, blit to the image
+    GLuint msaaFramebuffer[MAX_VIEWS];
+    GLuint msaaColorBuffer[MAX_VIEWS];
+    PFNGLFRAMEBUFFERTEXTURE2DMULTISAMPLEEXTPROC glFramebufferTexture2DMultisampleEXT;
+    PFNGLRENDERBUFFERSTORAGEMULTISAMPLEEXTPROC glRenderbufferStorageMultisampleEXT;
+    PFNGLFRAMEBUFFERTEXTUREMULTISAMPLEMULTIVIEWOVRPROC glFramebufferTextureMultisampleMultiviewOVR;
+    
+    // Single-pass stereo (GL_OVR_multiview2)
+    bool multiview;
+    GLuint depthTextureArray;
+    PFNGLFRAMEBUFFERTEXTUREMULTIVIEWOVRPROC glFramebufferTextureMultiviewOVR;
     
     // View config
     XrViewConfigurationView viewConfig[MAX_VIEWS];
-    XrView views[MAX_VIEWS];
     uint32_t viewCount;
     
+    // Dynamic resolution (FLAG_VR_DYNAMIC_RESOLUTION): each frame renders
+    // into the lower-left renderWidth x renderHeight of the swapchain image
+    float resolutionScale;              // Relative to the recommended size; written under frameStats.lock
+    uint64_t resolutionScaleFrame;      // First frame rendered at the current scale
+    GLsizei renderWidth[MAX_VIEWS];
+    GLsizei renderHeight[MAX_VIEWS];
+    
     // Actions (input)
     XrActionSet actionSet;
     XrAction poseAction;
@@ -85,8 +166,18 @@ typedef struct {
     bool sessionRunning;
     bool sessionFocused;
     bool shouldExit;
+    bool updateThisFrame;       // False = draws are ignored, last frame's commands re-render
+    VRDrawSpace drawSpace;      // Space recorded with each draw (BeginVRDrawSpace)
+    uint32_t unfocusedFrames;
     XrSessionState sessionState;
     XrTime predictedDisplayTime;
+    XrDuration predictedDisplayPeriod;
+    
+    // Frame timing
+    XrTime lastDisplayTime;         // Previous frame, for missed-frame detection
+    XrTime lastUpdateDisplayTime;   // Last frame the app updated (recorded time during playback)
+    float frameTime;                // Seconds between the app's last two updates
+    int missedFrames;
     
     // Input state
     VRController controllers[2];
@@ -95,8 +186,8 @@ typedef struct {
     // Rendering
     Color clearColor;
     int currentEye;
-    Matrix currentViewMatrix;
-    Matrix currentProjectionMatrix;
+    RenderFrame frame;              // Frame being recorded by the app
+    float submitTimeMs;             // CPU time of the last EndVRMode submit
     
     // Player position offset (for locomotion)
     Vector3 playerPosition;
@@ -107,6 +198,14 @@ typedef struct {
 
 static VRState vrState = {0};
 
+// Frame the render path reads: vrState.frame, or the render thread's copy
+static RenderFrame* renderFrame = &vrState.frame;
+
+// Set before InitApp, so it lives outside vrState (which InitApp clears)
+static unsigned int vrConfigFlags = 0;
+static float vrResolutionScaleMin = VR_RESOLUTION_SCALE_MIN;
+static float vrResolutionScaleMax = VR_RESOLUTION_SCALE_MAX;
+
 // =============================================================================
 // Accessor Functions for Hand Tracking Module
 // =============================================================================
@@ -134,45 +233,410 @@ bool IsVRSessionRunning(void) {
 // =============================================================================
 // OpenGL resources (forward declared, initialized later)
 static GLuint shaderProgram = 0;
-static GLint uniformMVP = -1;
-static GLint uniformColor = -1;
-static GLuint cubeVAO = 0;
-static GLuint cubeVBO = 0;
-static GLuint cubeEBO = 0;
+
+// Instanced mesh rendering (one draw call per mesh type and LOD)
+static GLuint instancedProgram = 0;
+static GLuint meshVAO = 0;
+static GLuint meshVBO = 0;
+static GLuint meshEBO = 0;
+static GLuint instancePositionVBO = 0;
+static GLuint instanceSizeVBO = 0;
+static GLuint instanceRotationVBO = 0;
+static GLuint instanceColorVBO = 0;
+static GLuint instanceSpaceVBO = 0;
+
+// View-projection uniform buffers, written once per frame: one per eye in
+// two-pass mode, or a single buffer holding both matrices for multiview
+#define VIEW_BLOCK_BINDING 0
+static GLuint viewUBO[MAX_VIEWS] = {0};
+
+// Batched line rendering (one draw call per eye for all lines)
+static GLuint lineVAO = 0;
+static GLuint linePositionVBO = 0;
+static GLuint lineColorVBO = 0;
+static GLuint lineSpaceVBO = 0;
+
+// Hand renderer: both hands' joints in one uniform block, drawn as two
+// instanced draws (joint spheres, bone capsules)
+#define HAND_BLOCK_BINDING 1
+static GLuint handProgram = 0;
+static GLuint handVAO = 0;
+static GLuint handBoneVBO = 0;
+static GLuint handUBO = 0;
+static GLint handBonesLocation = -1;
+
+// Glyph renderer: every character of the frame's text is one quad instance
+// sampled from a signed distance field atlas, all drawn in one call
+static GLuint textProgram = 0;
+static GLuint textVAO = 0;
+static GLuint textQuadVBO = 0;
+static GLuint textInstanceVBO = 0;
+static GLuint textAtlasTexture = 0;
+
+// Late-latch correction per VRDrawSpace (column-major, world = identity),
+// written just before the eyes render
+static float drawSpaceCorrection[VR_SPACE_COUNT][16];
 
 // =============================================================================
 // Draw Command Buffer (for deferred rendering to each eye)
 // =============================================================================
 
+// Commands are stored per type as struct-of-arrays streams. Each array maps
+// 1:1 onto a vertex attribute, so EndVRMode uploads them without re-packing.
+// Colors are packed RGBA8 and normalized by the vertex fetch.
+
+// Meshes in the shared geometry cache; every type is drawn instanced
 typedef enum {
-    CMD_DRAW_CUBE,
-    CMD_DRAW_LINE,
-} DrawCommandType;
+    MESH_CUBE,
+    MESH_SPHERE,
+    MESH_CYLINDER,
+    MESH_CONE,
+    MESH_COUNT
+} MeshType;
+
+typedef struct {
+    Vector3* positions;
+    Vector4* sizes;         // xyz scale, w = top/bottom radius ratio (taper)
+    Quaternion* rotations;
+    Color* colors;
+    unsigned char* spaces;  // VRDrawSpace the instance follows
+    int count;
+    int capacity;
+} InstanceStream;
+
+typedef struct {
+    Vector3* positions;     // Two vertices per line: start, end
+    Color* colors;          // Per vertex, duplicated for both ends
+    unsigned char* spaces;  // Per vertex, like colors
+    int count;              // Number of lines
+    int capacity;
+} LineStream;
+
+// Streams live in a frame arena: reset every frame, grown on demand, never
+// shrunk, so after the first busy frame recording no longer allocates
+#define INITIAL_DRAW_COMMANDS 4096
+#define IDENTITY_ROTATION (Quaternion){ 0.0f, 0.0f, 0.0f, 1.0f }
+#define MAX_DRAW_COMMANDS (1 << 20)
+
+// Both hands as the hand renderer draws them. Joints are xyz + radius, with
+// radius 0 for joints that are not valid (their spheres and bones collapse)
+typedef struct {
+    float joints[2 * HAND_JOINT_COUNT][4];
+    Color jointColor[2];
+    Color boneColor[2];
+    unsigned char space[2];      // VRDrawSpace per hand
+    bool drawJoints[2];
+    bool drawBones[2];
+} HandDrawList;
+
+// One glyph quad: center plus half extents, and its cell in the font atlas
+typedef struct {
+    Vector3 center;
+    Vector3 halfRight;      // Along the text baseline
+    Vector3 halfUp;
+    float uv[4];            // Atlas rect: u0, v0 (top left), u1, v1
+    Color color;
+    unsigned char space;    // VRDrawSpace the glyph follows
+    unsigned char pad[3];
+} GlyphInstance;
+
+typedef struct {
+    GlyphInstance* instances;
+    int count;
+    int capacity;
+} GlyphStream;
+
+typedef struct {
+    InstanceStream meshes[MESH_COUNT];
+    LineStream lines;
+    GlyphStream glyphs;
+    HandDrawList hands;
+    int dropped;                 // Commands rejected this frame
+    int culled;                  // Commands outside both eye frusta this frame
+    int drawCalls;               // GL draw calls issued replaying this frame
+    int stateChanges;            // Non-redundant binds replaying this frame
+} DrawCommandArena;
 
+// The app records into one arena while the render path replays the other.
+// Without the render thread both point at drawArenas[0]
+static DrawCommandArena drawArenas[2] = {0};
+static DrawCommandArena* recordArena = &drawArenas[0];
+static DrawCommandArena* renderArena = &drawArenas[0];
+static int drawCommandPeak = 0;      // High-water mark of commands in one frame
+static VRDrawStats drawStats = {0};  // Stats of the last completed frame
+
+// Geometry cache: index range of each mesh LOD within meshEBO
+#define MESH_LOD_COUNT 3
+#define MESH_LOD0_MIN_PIXELS 48.0f   // Projected radius for full detail
+#define MESH_LOD1_MIN_PIXELS 12.0f   // Projected radius for medium detail
+
+typedef struct {
+    GLsizei indexCount;
+    GLsizei firstIndex;
+} MeshLOD;
+
+static MeshLOD meshLODs[MESH_COUNT][MESH_LOD_COUNT];
+
+// One draw call of the frame: a run of mesh instances with one LOD, or the
+// line stream. Batches are sorted by (primitive, program, geometry) so the
+// replay loop binds each program and VAO as few times as possible.
+typedef struct {
+    uint64_t sortKey;
+    GLenum primitive;
+    GLuint program;
+    GLuint vao;
+    MeshType mesh;           // Indexed meshes only
+    int lod;
+    int first;               // First instance (meshes) or vertex (lines)
+    int count;               // Instances (meshes) or vertices (lines)
+} RenderBatch;
+
+#define MAX_RENDER_BATCHES (MESH_COUNT * MESH_LOD_COUNT + 1)
+static RenderBatch renderBatches[MAX_RENDER_BATCHES];
+static int renderBatchCount = 0;
+
+// Last bound GL state, so replay skips redundant binds
 typedef struct {
-    DrawCommandType type;
-    Vector3 position;
-    Vector3 size;        // or end position for lines
-    Vector3 color;       // normalized 0-1
-} DrawCommand;
+    GLuint program;
+    GLuint vao;
+    int instanceOffset;      // First instance the mesh VAO's attributes point at
+    int stateChanges;        // Program/VAO/attribute rebinds this frame
+    int drawCalls;           // Draw calls this frame
+} GLStateCache;
+
+static GLStateCache glCache = { 0, 0, -1, 0, 0 };
+
+// LOD-aware meshes are re-ordered by LOD into this staging stream each frame
+static InstanceStream lodStaging = {0};
+static unsigned char* lodScratch = NULL;
+
+// Next capacity for a stream that must hold `needed` elements, or 0 if over the limit
+static int NextStreamCapacity(int capacity, int needed) {
+    if (needed > MAX_DRAW_COMMANDS) return 0;
+    if (capacity == 0) capacity = INITIAL_DRAW_COMMANDS;
+    while (capacity < needed) capacity *= 2;
+    return (capacity > MAX_DRAW_COMMANDS) ? MAX_DRAW_COMMANDS : capacity;
+}
+
+static bool GrowInstanceStream(InstanceStream* stream, int needed) {
+    int capacity = NextStreamCapacity(stream->capacity, needed);
+    if (capacity == 0) return false;
+    
+    Vector3* positions = realloc(stream->positions, capacity * sizeof(Vector3));
+    if (positions == NULL) return false;
+    stream->positions = positions;
+    
+    Vector4* sizes = realloc(stream->sizes, capacity * sizeof(Vector4));
+    if (sizes == NULL) return false;
+    stream->sizes = sizes;
+    
+    Quaternion* rotations = realloc(stream->rotations, capacity * sizeof(Quaternion));
+    if (rotations == NULL) return false;
+    stream->rotations = rotations;
+    
+    Color* colors = realloc(stream->colors, capacity * sizeof(Color));
+    if (colors == NULL) return false;
+    stream->colors = colors;
+    
+    unsigned char* spaces = realloc(stream->spaces, capacity);
+    if (spaces == NULL) return false;
+    stream->spaces = spaces;
+    
+    LOGI("Instance stream grown: %d -> %d commands", stream->capacity, capacity);
+    stream->capacity = capacity;
+    return true;
+}
+
+static void FreeInstanceStream(InstanceStream* stream) {
+    free(stream->positions);
+    free(stream->sizes);
+    free(stream->rotations);
+    free(stream->colors);
+    free(stream->spaces);
+    memset(stream, 0, sizeof(*stream));
+}
+
+static bool GrowLineStream(LineStream* stream) {
+    int capacity = NextStreamCapacity(stream->capacity, stream->count + 1);
+    if (capacity == 0) return false;
+    
+    Vector3* positions = realloc(stream->positions, capacity * 2 * sizeof(Vector3));
+    if (positions == NULL) return false;
+    stream->positions = positions;
+    
+    Color* colors = realloc(stream->colors, capacity * 2 * sizeof(Color));
+    if (colors == NULL) return false;
+    stream->colors = colors;
+    
+    unsigned char* spaces = realloc(stream->spaces, capacity * 2);
+    if (spaces == NULL) return false;
+    stream->spaces = spaces;
+    
+    LOGI("Line stream grown: %d -> %d commands", stream->capacity, capacity);
+    stream->capacity = capacity;
+    return true;
+}
+
+static bool GrowGlyphStream(GlyphStream* stream) {
+    int capacity = NextStreamCapacity(stream->capacity, stream->count + 1);
+    if (capacity == 0) return false;
+    
+    GlyphInstance* instances = realloc(stream->instances, capacity * sizeof(GlyphInstance));
+    if (instances == NULL) return false;
+    stream->instances = instances;
+    
+    LOGI("Glyph stream grown: %d -> %d commands", stream->capacity, capacity);
+    stream->capacity = capacity;
+    return true;
+}
+
+static void FreeDrawCommands(void) {
+    for (int a = 0; a < 2; a++) {
+        DrawCommandArena* arena = &drawArenas[a];
+        for (int m = 0; m < MESH_COUNT; m++) {
+            FreeInstanceStream(&arena->meshes[m]);
+        }
+        free(arena->lines.positions);
+        free(arena->lines.colors);
+        free(arena->lines.spaces);
+        free(arena->glyphs.instances);
+        memset(arena, 0, sizeof(*arena));
+    }
+    FreeInstanceStream(&lodStaging);
+    free(lodScratch);
+    lodScratch = NULL;
+    drawCommandPeak = 0;
+}
 
-#define MAX_DRAW_COMMANDS 4096
-static DrawCommand drawCommands[MAX_DRAW_COMMANDS];
-static int drawCommandCount = 0;
+static int GetDrawCommandCount(const DrawCommandArena* arena) {
+    int count = arena->lines.count + arena->glyphs.count;
+    for (int m = 0; m < MESH_COUNT; m++) {
+        count += arena->meshes[m].count;
+    }
+    return count;
+}
 
+// Reset the record arena for a new frame. Its previous contents have been
+// replayed by now, so their stats become the last completed frame's
 static void ClearDrawCommands(void) {
-    drawCommandCount = 0;
+    DrawCommandArena* arena = recordArena;
+    int capacity = 0;
+    for (int a = 0; a < 2; a++) {
+        capacity += drawArenas[a].lines.capacity + drawArenas[a].glyphs.capacity;
+        for (int m = 0; m < MESH_COUNT; m++) {
+            capacity += drawArenas[a].meshes[m].capacity;
+        }
+    }
+    
+    drawStats = (VRDrawStats){
+        .commandsSubmitted = GetDrawCommandCount(arena) + arena->culled + arena->dropped,
+        .commandsDropped = arena->dropped,
+        .commandsCulled = arena->culled,
+        .commandsVisible = GetDrawCommandCount(arena),
+        .drawCalls = arena->drawCalls,
+        .stateChanges = arena->stateChanges,
+        .peakCommands = drawCommandPeak,
+        .capacity = capacity
+    };
+    for (int m = 0; m < MESH_COUNT; m++) {
+        arena->meshes[m].count = 0;
+    }
+    arena->lines.count = 0;
+    arena->glyphs.count = 0;
+    memset(arena->hands.drawJoints, 0, sizeof(arena->hands.drawJoints));
+    memset(arena->hands.drawBones, 0, sizeof(arena->hands.drawBones));
+    arena->dropped = 0;
+    arena->culled = 0;
+    arena->drawCalls = 0;
+    arena->stateChanges = 0;
+}
+
+static void DropDrawCommand(void) {
+    if (recordArena->dropped++ == 0) {
+        LOGE("Draw command arena full at %d commands - dropping geometry this frame", GetDrawCommandCount(recordArena));
+    }
+}
+
+static void UpdateDrawCommandPeak(void) {
+    int count = GetDrawCommandCount(recordArena);
+    if (count > drawCommandPeak) {
+        drawCommandPeak = count;
+    }
+}
+
+static void RecordMesh(MeshType mesh, Vector3 position, Vector4 size, Quaternion rotation, Color color) {
+    if (!vrState.updateThisFrame) return;
+    
+    InstanceStream* stream = &recordArena->meshes[mesh];
+    if (stream->count == stream->capacity && !GrowInstanceStream(stream, stream->count + 1)) {
+        DropDrawCommand();
+        return;
+    }
+    
+    stream->positions[stream->count] = position;
+    stream->sizes[stream->count] = size;
+    stream->rotations[stream->count] = rotation;
+    stream->colors[stream->count] = color;
+    stream->spaces[stream->count] = (unsigned char)vrState.drawSpace;
+    stream->count++;
+    UpdateDrawCommandPeak();
+}
+
+static void RecordLine(Vector3 startPos, Vector3 endPos, Color color) {
+    if (!vrState.updateThisFrame) return;
+    
+    LineStream* stream = &recordArena->lines;
+    if (stream->count == stream->capacity && !GrowLineStream(stream)) {
+        DropDrawCommand();
+        return;
+    }
+    
+    int v = stream->count * 2;
+    stream->positions[v] = startPos;
+    stream->positions[v + 1] = endPos;
+    stream->colors[v] = color;
+    stream->colors[v + 1] = color;
+    stream->spaces[v] = (unsigned char)vrState.drawSpace;
+    stream->spaces[v + 1] = (unsigned char)vrState.drawSpace;
+    stream->count++;
+    UpdateDrawCommandPeak();
 }
 
-static void AddDrawCommand(DrawCommand cmd) {
-    if (drawCommandCount < MAX_DRAW_COMMANDS) {
-        drawCommands[drawCommandCount++] = cmd;
+static void RecordGlyphQuad(Vector3 center, Vector3 halfRight, Vector3 halfUp, const float uv[4], Color color) {
+    if (!vrState.updateThisFrame) return;
+    
+    GlyphStream* stream = &recordArena->glyphs;
+    if (stream->count == stream->capacity && !GrowGlyphStream(stream)) {
+        DropDrawCommand();
+        return;
     }
-    // Log occasionally for debugging
-    static int logCounter = 0;
-    if (++logCounter % 1000 == 0) {
-        LOGD("Draw commands this frame: %d", drawCommandCount);
+    
+    GlyphInstance* glyph = &stream->instances[stream->count];
+    glyph->center = center;
+    glyph->halfRight = halfRight;
+    glyph->halfUp = halfUp;
+    memcpy(glyph->uv, uv, sizeof(glyph->uv));
+    glyph->color = color;
+    glyph->space = (unsigned char)vrState.drawSpace;
+    stream->count++;
+    UpdateDrawCommandPeak();
+}
+
+// Copy one hand's packed joints into the record arena
+static HandDrawList* RecordHandPose(int hand, const VRHandJoints* joints) {
+    if (!vrState.updateThisFrame || hand < 0 || hand > 1) return NULL;
+    
+    HandDrawList* list = &recordArena->hands;
+    float (*dst)[4] = &list->joints[hand * HAND_JOINT_COUNT];
+    for (int j = 0; j < HAND_JOINT_COUNT; j++) {
+        bool valid = (joints->validMask >> j) & 1u;
+        dst[j][0] = joints->x[j];
+        dst[j][1] = joints->y[j];
+        dst[j][2] = joints->z[j];
+        dst[j][3] = valid ? fmaxf(joints->radius[j], 0.005f) : 0.0f;  // Minimum visible size
     }
+    list->space[hand] = (unsigned char)vrState.drawSpace;
+    return list;
 }
 
 // =============================================================================
@@ -193,10 +657,36 @@ static void UpdateInput(void);
 static void BeginFrame(void);
 static void EndFrame(void);
 static void RenderEye(int eye, uint32_t imageIndex);
+static void RenderMultiview(uint32_t imageIndex);
+static void ReplayDrawCommands(void);
 static void InitShaders(void);
-static void InitCubeGeometry(void);
-static void DrawCubeInternal(Vector3 position, Vector3 size, Vector3 color);
-static void DrawLineInternal(Vector3 startPos, Vector3 endPos, Vector3 color);
+static void InitMeshGeometry(void);
+static void InitLineGeometry(void);
+static void InitHandRenderer(void);
+static void InitTextRenderer(void);
+static void CullDrawCommands(void);
+static void UploadDrawStreams(void);
+static void UploadViewUniforms(void);
+static void DrawRenderBatches(void);
+static void UploadHandBlock(void);
+static void DrawHandBatches(void);
+static void DrawTextBatch(void);
+static void BeginXrFrame(void);
+static void RenderRecordedFrame(void);
+static void WaitForRenderThread(void);
+
+// Input capture hooks (realitylib_capture.c)
+extern void RecordFrameViews(XrTime displayTime, const XrView* views, uint32_t viewCount);
+extern void RecordControllers(const VRController* controllers, const VRHeadset* headset);
+extern void RecordFrameEnd(void);
+extern bool PlaybackFrameViews(XrTime* displayTime, XrView* views, uint32_t viewCount);
+extern bool PlaybackControllers(VRController* controllers, VRHeadset* headset);
+extern void StopInputRecording(void);
+extern void StopInputPlayback(void);
+extern bool IsInputPlaybackActive(void);
+
+// Font atlas hook (realitylib_text.c)
+extern const unsigned char* GetFontAtlas(int* width, int* height);
 
 // Helper to check XR results
 static bool XrCheck(XrResult result, const char* operation) {
@@ -303,24 +793,6 @@ static Matrix MatrixMultiply(Matrix left, Matrix right) {
     return result;
 }
 
-static Matrix MatrixTranslate(float x, float y, float z) {
-    Matrix m = MatrixIdentity();
-    m.m12 = x;
-    m.m13 = y;
-    m.m14 = z;
-    return m;
-}
-
-static Matrix MatrixScale(float x, float y, float z) {
-    Matrix m = {
-        x, 0.0f, 0.0f, 0.0f,
-        0.0f, y, 0.0f, 0.0f,
-        0.0f, 0.0f, z, 0.0f,
-        0.0f, 0.0f, 0.0f, 1.0f
-    };
-    return m;
-}
-
 static Matrix QuaternionToMatrix(Quaternion q) {
     Matrix m = MatrixIdentity();
     
@@ -390,6 +862,18 @@ static Matrix CreateTranslation(float x, float y, float z) {
     return m;
 }
 
+// Tracking-space position to world space (player yaw, then player offset)
+static Vector3 TrackingToWorld(XrVector3f p) {
+    float playerYawRad = vrState.playerYaw * PI / 180.0f;
+    float cosYaw = cosf(playerYawRad);
+    float sinYaw = sinf(playerYawRad);
+    return (Vector3){
+        p.x * cosYaw - p.z * sinYaw + vrState.playerPosition.x,
+        p.y + vrState.playerPosition.y,
+        p.x * sinYaw + p.z * cosYaw + vrState.playerPosition.z
+    };
+}
+
 static Matrix CreateViewMatrix(XrPosef pose) {
     // First, create the base view matrix from headset pose
     // Invert the pose for view matrix
@@ -438,14 +922,61 @@ static Matrix CreateViewMatrix(XrPosef pose) {
     return combinedRot;
 }
 
+// Rigid transform that moves geometry placed relative to pose `from` to the
+// same place relative to pose `to`: rotate by to * from^-1, then fix up the origin
+static Matrix PoseCorrectionMatrix(XrPosef from, XrPosef to) {
+    XrQuaternionf a = to.orientation;
+    XrQuaternionf b = { -from.orientation.x, -from.orientation.y, -from.orientation.z, from.orientation.w };
+    Quaternion delta = {
+        a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+        a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+        a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+        a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z
+    };
+    
+    Matrix m = QuaternionToMatrix(delta);
+    XrVector3f p = from.position;
+    m.m12 = to.position.x - (m.m0 * p.x + m.m4 * p.y + m.m8 * p.z);
+    m.m13 = to.position.y - (m.m1 * p.x + m.m5 * p.y + m.m9 * p.z);
+    m.m14 = to.position.z - (m.m2 * p.x + m.m6 * p.y + m.m10 * p.z);
+    return m;
+}
+
+// Convert to column-major float array for OpenGL
+static void MatrixToFloatArray(Matrix m, float* out) {
+    out[0] = m.m0;   out[1] = m.m1;   out[2] = m.m2;   out[3] = m.m3;
+    out[4] = m.m4;   out[5] = m.m5;   out[6] = m.m6;   out[7] = m.m7;
+    out[8] = m.m8;   out[9] = m.m9;   out[10] = m.m10; out[11] = m.m11;
+    out[12] = m.m12; out[13] = m.m13; out[14] = m.m14; out[15] = m.m15;
+}
+
+static float NanosecondsToSeconds(XrDuration ns) {
+    return (float)((double)ns * 1e-9);
+}
+
+static double GetTimeMs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
 // =============================================================================
 // EGL Initialization
 // =============================================================================
 
+#ifdef REALITYLIB_HEADLESS
+// Provided by headless/realitylib_headless.c (Mesa surfaceless platform)
+EGLDisplay GetHeadlessEGLDisplay(void);
+#endif
+
 static bool InitializeEGL(void) {
     LOGI("Initializing EGL...");
     
+#ifdef REALITYLIB_HEADLESS
+    vrState.eglDisplay = GetHeadlessEGLDisplay();
+#else
     vrState.eglDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+#endif
     if (vrState.eglDisplay == EGL_NO_DISPLAY) {
         LOGE("Failed to get EGL display");
         return false;
@@ -465,6 +996,9 @@ static bool InitializeEGL(void) {
         EGL_ALPHA_SIZE, 8,
         EGL_DEPTH_SIZE, 24,
         EGL_RENDERABLE_TYPE, EGL_OPENGL_ES3_BIT_KHR,
+#ifdef REALITYLIB_HEADLESS
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,  // Surfaceless configs default to no surface types
+#endif
         EGL_NONE
     };
     
@@ -772,9 +1306,299 @@ static void DestroySession(void) {
 // Swapchain Management
 // =============================================================================
 
+static bool InitMultiview(void) {
+    if (vrConfigFlags & FLAG_VR_NO_MULTIVIEW) {
+        LOGI("Multiview disabled by config flag - using two-pass stereo");
+        return false;
+    }
+    if (vrState.viewCount != 2) return false;
+    
+    const char* glExtensions = (const char*)glGetString(GL_EXTENSIONS);
+    if (glExtensions == NULL || strstr(glExtensions, "GL_OVR_multiview2") == NULL) {
+        LOGI("GL_OVR_multiview2 not available - using two-pass stereo");
+        return false;
+    }
+    
+    vrState.glFramebufferTextureMultiviewOVR = (PFNGLFRAMEBUFFERTEXTUREMULTIVIEWOVRPROC)
+        eglGetProcAddress("glFramebufferTextureMultiviewOVR");
+    if (vrState.glFramebufferTextureMultiviewOVR == NULL) {
+        LOGE("glFramebufferTextureMultiviewOVR not found - using two-pass stereo");
+        return false;
+    }
+    return true;
+}
+
+// Depth format from the config flags. Nothing in RealityLib uses stencil, so
+// the depth-only formats are safe to pick; 16-bit halves depth bandwidth.
+// The layered (multiview) depth texture never had stencil
+static void SelectDepthFormat(bool layered) {
+    if (vrConfigFlags & FLAG_VR_DEPTH_16) {
+        vrState.depthFormat = GL_DEPTH_COMPONENT16;
+    } else if ((vrConfigFlags & FLAG_VR_DEPTH_NO_STENCIL) || layered) {
+        vrState.depthFormat = GL_DEPTH_COMPONENT24;
+    } else {
+        vrState.depthFormat = GL_DEPTH24_STENCIL8;
+    }
+    vrState.depthAttachment = (vrState.depthFormat == GL_DEPTH24_STENCIL8) ?
+        GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
+    LOGI("Depth format: %s", vrState.depthFormat == GL_DEPTH_COMPONENT16 ? "D16" :
+        vrState.depthFormat == GL_DEPTH_COMPONENT24 ? "D24" : "D24S8");
+}
+
+// Sample count from the config flags. With GL_EXT_multisampled_render_to_texture
+// (or its multiview variant) the samples only live in tile memory and are
+// resolved as tiles are written out. Two-pass stereo without it falls back to
+// a multisampled framebuffer and a resolve blit; multiview without it renders
+// without MSAA
+static void SelectMSAASamples(bool layered) {
+    int requested = (vrConfigFlags & FLAG_VR_MSAA_4X) ? 4 : (vrConfigFlags & FLAG_VR_MSAA_2X) ? 2 : 1;
+    vrState.msaaSamples = 1;
+    vrState.msaaResolveBlit = false;
+    if (requested == 1) return;
+    
+    const char* glExtensions = (const char*)glGetString(GL_EXTENSIONS);
+    if (glExtensions == NULL) glExtensions = "";
+    GLint maxSamples = 1;
+    
+    if (layered) {
+        if (strstr(glExtensions, "GL_OVR_multiview_multisampled_render_to_texture") != NULL) {
+            vrState.glFramebufferTextureMultisampleMultiviewOVR = (PFNGLFRAMEBUFFERTEXTUREMULTISAMPLEMULTIVIEWOVRPROC)
+                eglGetProcAddress("glFramebufferTextureMultisampleMultiviewOVR");
+        }
+        if (vrState.glFramebufferTextureMultisampleMultiviewOVR == NULL) {
+            LOGI("GL_OVR_multiview_multisampled_render_to_texture not available - MSAA off");
+            return;
+        }
+        glGetIntegerv(GL_MAX_SAMPLES_EXT, &maxSamples);
+    } else {
+        if (strstr(glExtensions, "GL_EXT_multisampled_render_to_texture") != NULL) {
+            vrState.glFramebufferTexture2DMultisampleEXT = (PFNGLFRAMEBUFFERTEXTURE2DMULTISAMPLEEXTPROC)
+                eglGetProcAddress("glFramebufferTexture2DMultisampleEXT");
+            vrState.glRenderbufferStorageMultisampleEXT = (PFNGLRENDERBUFFERSTORAGEMULTISAMPLEEXTPROC)
+                eglGetProcAddress("glRenderbufferStorageMultisampleEXT");
+        }
+        if (vrState.glFramebufferTexture2DMultisampleEXT != NULL && vrState.glRenderbufferStorageMultisampleEXT != NULL) {
+            glGetIntegerv(GL_MAX_SAMPLES_EXT, &maxSamples);
+        } else {
+            vrState.msaaResolveBlit = true;
+            glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+        }
+    }
+    
+    vrState.msaaSamples = (requested < maxSamples) ? requested : maxSamples;
+    if (vrState.msaaSamples < 2) {
+        vrState.msaaSamples = 1;
+        vrState.msaaResolveBlit = false;
+    }
+    LOGI("MSAA: %dx (%s)", vrState.msaaSamples,
+        vrState.msaaSamples == 1 ? "unsupported" : vrState.msaaResolveBlit ? "resolve blit" : "on-tile resolve");
+}
+
+// Depth storage for one eye; multisampled when MSAA is on
+static void AllocateDepthBuffer(uint32_t eye, GLsizei width, GLsizei height) {
+    glGenRenderbuffers(1, &vrState.depthBuffer[eye]);
+    glBindRenderbuffer(GL_RENDERBUFFER, vrState.depthBuffer[eye]);
+    if (vrState.msaaSamples > 1 && vrState.msaaResolveBlit) {
+        glRenderbufferStorageMultisample(GL_RENDERBUFFER, vrState.msaaSamples, vrState.depthFormat, width, height);
+    } else if (vrState.msaaSamples > 1) {
+        vrState.glRenderbufferStorageMultisampleEXT(GL_RENDERBUFFER, vrState.msaaSamples, vrState.depthFormat, width, height);
+    } else {
+        glRenderbufferStorage(GL_RENDERBUFFER, vrState.depthFormat, width, height);
+    }
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+}
+
+// Fallback MSAA target for one eye: multisampled color + depth, resolved
+// into the swapchain image's framebuffer with a blit after the eye renders
+static bool CreateMSAAFramebuffer(uint32_t eye, GLsizei width, GLsizei height) {
+    glGenRenderbuffers(1, &vrState.msaaColorBuffer[eye]);
+    glBindRenderbuffer(GL_RENDERBUFFER, vrState.msaaColorBuffer[eye]);
+    glRenderbufferStorageMultisample(GL_RENDERBUFFER, vrState.msaaSamples, GL_SRGB8_ALPHA8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    
+    glGenFramebuffers(1, &vrState.msaaFramebuffer[eye]);
+    glBindFramebuffer(GL_FRAMEBUFFER, vrState.msaaFramebuffer[eye]);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, vrState.msaaColorBuffer[eye]);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, vrState.depthAttachment, GL_RENDERBUFFER, vrState.depthBuffer[eye]);
+    
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        LOGE("MSAA framebuffer %d incomplete: 0x%x", eye, status);
+        return false;
+    }
+    return true;
+}
+
+// Build one framebuffer per swapchain image up front, so a frame only binds
+// the one for the acquired image instead of re-attaching textures
+static bool CreateSwapchainFramebuffers(uint32_t s, bool layered) {
+    uint32_t count = vrState.swapchainLength[s];
+    vrState.framebuffers[s] = calloc(count, sizeof(GLuint));
+    if (vrState.framebuffers[s] == NULL) return false;
+    glGenFramebuffers(count, vrState.framebuffers[s]);
+    
+    bool complete = true;
+    for (uint32_t j = 0; j < count; j++) {
+        GLuint image = vrState.swapchainImages[s][j].image;
+        glBindFramebuffer(GL_FRAMEBUFFER, vrState.framebuffers[s][j]);
+        if (layered && vrState.msaaSamples > 1) {
+            vrState.glFramebufferTextureMultisampleMultiviewOVR(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                image, 0, vrState.msaaSamples, 0, 2);
+            vrState.glFramebufferTextureMultisampleMultiviewOVR(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+                vrState.depthTextureArray, 0, vrState.msaaSamples, 0, 2);
+        } else if (layered) {
+            vrState.glFramebufferTextureMultiviewOVR(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, image, 0, 0, 2);
+            vrState.glFramebufferTextureMultiviewOVR(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+                vrState.depthTextureArray, 0, 0, 2);
+        } else if (vrState.msaaSamples > 1 && !vrState.msaaResolveBlit) {
+            vrState.glFramebufferTexture2DMultisampleEXT(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                image, 0, vrState.msaaSamples);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, vrState.depthAttachment,
+                GL_RENDERBUFFER, vrState.depthBuffer[s]);
+        } else if (vrState.msaaSamples > 1) {
+            // Resolve target only: depth lives in the MSAA framebuffer
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, image, 0);
+        } else {
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, image, 0);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, vrState.depthAttachment,
+                GL_RENDERBUFFER, vrState.depthBuffer[s]);
+        }
+        
+        GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        if (status != GL_FRAMEBUFFER_COMPLETE) {
+            LOGE("Swapchain %d image %d framebuffer incomplete: 0x%x", s, j, status);
+            complete = false;
+        }
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return complete;
+}
+
+// Swapchain images are allocated once at the largest size dynamic resolution
+// can reach, so changing the scale never reallocates
+static void SelectImageSizes(void) {
+    bool dynamic = (vrConfigFlags & FLAG_VR_DYNAMIC_RESOLUTION) != 0;
+    float maxScale = dynamic ? vrResolutionScaleMax : 1.0f;
+    
+    for (uint32_t i = 0; i < vrState.viewCount; i++) {
+        const XrViewConfigurationView* config = &vrState.viewConfig[i];
+        uint32_t width = (uint32_t)ceilf(config->recommendedImageRectWidth * maxScale);
+        uint32_t height = (uint32_t)ceilf(config->recommendedImageRectHeight * maxScale);
+        if (config->maxImageRectWidth > 0 && width > config->maxImageRectWidth) width = config->maxImageRectWidth;
+        if (config->maxImageRectHeight > 0 && height > config->maxImageRectHeight) height = config->maxImageRectHeight;
+        vrState.imageWidth[i] = width;
+        vrState.imageHeight[i] = height;
+    }
+    
+    vrState.resolutionScale = 1.0f;
+    vrState.resolutionScaleFrame = 0;
+    if (dynamic) {
+        LOGI("Dynamic resolution: scale %.2f-%.2f, images %dx%d",
+            vrResolutionScaleMin, vrResolutionScaleMax, vrState.imageWidth[0], vrState.imageHeight[0]);
+    }
+}
+
+// Size of this frame's render rect at the current scale, clamped to the images
+static void ApplyResolutionScale(void) {
+    for (uint32_t i = 0; i < vrState.viewCount; i++) {
+        GLsizei width = (GLsizei)(vrState.viewConfig[i].recommendedImageRectWidth * vrState.resolutionScale + 0.5f);
+        GLsizei height = (GLsizei)(vrState.viewConfig[i].recommendedImageRectHeight * vrState.resolutionScale + 0.5f);
+        vrState.renderWidth[i] = (width < 1) ? 1 : (width > (GLsizei)vrState.imageWidth[i]) ? (GLsizei)vrState.imageWidth[i] : width;
+        vrState.renderHeight[i] = (height < 1) ? 1 : (height > (GLsizei)vrState.imageHeight[i]) ? (GLsizei)vrState.imageHeight[i] : height;
+    }
+    renderFrame->stats.resolutionScale = vrState.resolutionScale;
+}
+
+// Next scale from the GPU time of a frame rendered at renderedScale. Pixel
+// cost goes with the square of the scale, so the estimate for the budget
+// uses its square root. Over budget the scale drops towards the estimate by
+// at most 0.1 per result; it only climbs back while well under budget and
+// in small steps, so it does not oscillate around the limit
+static float NextResolutionScale(float gpuMs, float renderedScale) {
+    float budgetMs = GetPredictedDisplayPeriod() * 1000.0f * VR_RESOLUTION_GPU_BUDGET;
+    float scale = vrState.resolutionScale;
+    float target = renderedScale * sqrtf(budgetMs / gpuMs);
+    
+    if (gpuMs > budgetMs) {
+        scale = fminf(scale, fmaxf(target, scale - 0.1f));
+    } else if (gpuMs < budgetMs * 0.8f) {
+        scale = fmaxf(scale, fminf(target, scale + 0.02f));
+    }
+    return fminf(fmaxf(scale, vrResolutionScaleMin), vrResolutionScaleMax);
+}
+
+static bool CreateMultiviewSwapchain(void) {
+    uint32_t width = vrState.imageWidth[0];
+    uint32_t height = vrState.imageHeight[0];
+    
+    XrSwapchainCreateInfo swapchainInfo = {
+        .type = XR_TYPE_SWAPCHAIN_CREATE_INFO,
+        .next = NULL,
+        .createFlags = 0,
+        .usageFlags = XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT | XR_SWAPCHAIN_USAGE_SAMPLED_BIT,
+        .format = GL_SRGB8_ALPHA8,
+        .sampleCount = 1,
+        .width = width,
+        .height = height,
+        .faceCount = 1,
+        .arraySize = 2,
+        .mipCount = 1
+    };
+    
+    XrResult result = xrCreateSwapchain(vrState.session, &swapchainInfo, &vrState.swapchain[0]);
+    if (XR_FAILED(result)) {
+        LOGE("Failed to create array swapchain (%d) - using two-pass stereo", result);
+        vrState.swapchain[0] = XR_NULL_HANDLE;
+        return false;
+    }
+    
+    xrEnumerateSwapchainImages(vrState.swapchain[0], 0, &vrState.swapchainLength[0], NULL);
+    
+    vrState.swapchainImages[0] = malloc(vrState.swapchainLength[0] * sizeof(XrSwapchainImageOpenGLESKHR));
+    for (uint32_t j = 0; j < vrState.swapchainLength[0]; j++) {
+        vrState.swapchainImages[0][j].type = XR_TYPE_SWAPCHAIN_IMAGE_OPENGL_ES_KHR;
+        vrState.swapchainImages[0][j].next = NULL;
+    }
+    
+    xrEnumerateSwapchainImages(vrState.swapchain[0], vrState.swapchainLength[0],
+        &vrState.swapchainLength[0], (XrSwapchainImageBaseHeader*)vrState.swapchainImages[0]);
+    
+    // Multiview needs a layered depth attachment too, so depth is a texture array
+    SelectDepthFormat(true);
+    SelectMSAASamples(true);
+    glGenTextures(1, &vrState.depthTextureArray);
+    
+    glBindTexture(GL_TEXTURE_2D_ARRAY, vrState.depthTextureArray);
+    glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, vrState.depthFormat, width, height, 2);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    
+    vrState.swapchainCount = 1;
+    if (!CreateSwapchainFramebuffers(0, true)) {
+        // Typically a layered (or multisampled layered) depth attachment the driver rejects
+        LOGE("Multiview framebuffers unusable - using two-pass stereo");
+        DestroySwapchains();
+        vrState.swapchainCount = 0;
+        return false;
+    }
+    LOGI("Multiview swapchain created: %d images, %dx%d x2 layers",
+        vrState.swapchainLength[0], width, height);
+    return true;
+}
+
 static bool CreateSwapchains(void) {
     LOGI("Creating swapchains...");
     
+    SelectImageSizes();
+    vrState.multiview = InitMultiview() && CreateMultiviewSwapchain();
+    if (vrState.multiview) {
+        return true;
+    }
+    
+    SelectDepthFormat(false);
+    SelectMSAASamples(false);
+    
+    vrState.swapchainCount = vrState.viewCount;
     for (uint32_t i = 0; i < vrState.viewCount; i++) {
         XrSwapchainCreateInfo swapchainInfo = {
             .type = XR_TYPE_SWAPCHAIN_CREATE_INFO,
@@ -783,8 +1607,8 @@ static bool CreateSwapchains(void) {
             .usageFlags = XR_SWAPCHAIN_USAGE_COLOR_ATTACHMENT_BIT | XR_SWAPCHAIN_USAGE_SAMPLED_BIT,
             .format = GL_SRGB8_ALPHA8,
             .sampleCount = 1,
-            .width = vrState.viewConfig[i].recommendedImageRectWidth,
-            .height = vrState.viewConfig[i].recommendedImageRectHeight,
+            .width = vrState.imageWidth[i],
+            .height = vrState.imageHeight[i],
             .faceCount = 1,
             .arraySize = 1,
             .mipCount = 1
@@ -804,33 +1628,47 @@ static bool CreateSwapchains(void) {
         xrEnumerateSwapchainImages(vrState.swapchain[i], vrState.swapchainLength[i], 
             &vrState.swapchainLength[i], (XrSwapchainImageBaseHeader*)vrState.swapchainImages[i]);
         
-        // Create framebuffer and depth buffer
-        glGenFramebuffers(1, &vrState.framebuffer[i]);
-        glGenRenderbuffers(1, &vrState.depthBuffer[i]);
-        
-        glBindRenderbuffer(GL_RENDERBUFFER, vrState.depthBuffer[i]);
-        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8,
-            vrState.viewConfig[i].recommendedImageRectWidth,
-            vrState.viewConfig[i].recommendedImageRectHeight);
+        // Depth buffer, shared by the framebuffers of every image of this eye
+        GLsizei width = vrState.imageWidth[i];
+        GLsizei height = vrState.imageHeight[i];
+        AllocateDepthBuffer(i, width, height);
+        if (vrState.msaaResolveBlit && !CreateMSAAFramebuffer(i, width, height)) {
+            return false;
+        }
+        if (!CreateSwapchainFramebuffers(i, false)) {
+            return false;
+        }
         
-        LOGI("Swapchain %d created: %d images, %dx%d", i, vrState.swapchainLength[i],
-            vrState.viewConfig[i].recommendedImageRectWidth,
-            vrState.viewConfig[i].recommendedImageRectHeight);
+        LOGI("Swapchain %d created: %d images, %dx%d", i, vrState.swapchainLength[i], width, height);
     }
     
     return true;
 }
 
 static void DestroySwapchains(void) {
-    for (uint32_t i = 0; i < vrState.viewCount; i++) {
-        if (vrState.framebuffer[i]) {
-            glDeleteFramebuffers(1, &vrState.framebuffer[i]);
-            vrState.framebuffer[i] = 0;
+    if (vrState.depthTextureArray) {
+        glDeleteTextures(1, &vrState.depthTextureArray);
+        vrState.depthTextureArray = 0;
+    }
+    
+    for (uint32_t i = 0; i < vrState.swapchainCount; i++) {
+        if (vrState.framebuffers[i]) {
+            glDeleteFramebuffers(vrState.swapchainLength[i], vrState.framebuffers[i]);
+            free(vrState.framebuffers[i]);
+            vrState.framebuffers[i] = NULL;
         }
         if (vrState.depthBuffer[i]) {
             glDeleteRenderbuffers(1, &vrState.depthBuffer[i]);
             vrState.depthBuffer[i] = 0;
         }
+        if (vrState.msaaFramebuffer[i]) {
+            glDeleteFramebuffers(1, &vrState.msaaFramebuffer[i]);
+            vrState.msaaFramebuffer[i] = 0;
+        }
+        if (vrState.msaaColorBuffer[i]) {
+            glDeleteRenderbuffers(1, &vrState.msaaColorBuffer[i]);
+            vrState.msaaColorBuffer[i] = 0;
+        }
         if (vrState.swapchainImages[i]) {
             free(vrState.swapchainImages[i]);
             vrState.swapchainImages[i] = NULL;
@@ -1048,8 +1886,16 @@ static void PollXREvents(void) {
                         break;
                     }
                     case XR_SESSION_STATE_STOPPING:
+                        // The frame in flight must be ended before the session
+                        WaitForRenderThread();
                         xrEndSession(vrState.session);
                         vrState.sessionRunning = false;
+                        
+                        // No frames run while stopped; the first one after a
+                        // restart only sets the baseline instead of counting the
+                        // whole pause as missed frames
+                        vrState.lastDisplayTime = 0;
+                        vrState.lastUpdateDisplayTime = 0;
                         LOGI("Session stopped");
                         break;
                     case XR_SESSION_STATE_EXITING:
@@ -1079,6 +1925,9 @@ static void PollXREvents(void) {
 static void UpdateInput(void) {
     if (!vrState.sessionRunning) return;
     
+    // Recorded input replaces the runtime's during playback
+    if (PlaybackControllers(vrState.controllers, &vrState.headset)) return;
+    
     // Sync actions
     XrActiveActionSet activeActionSet = {
         .actionSet = vrState.actionSet,
@@ -1213,81 +2062,491 @@ static void UpdateInput(void) {
         headLocation.pose.orientation.z,
         headLocation.pose.orientation.w
     };
+    
+    RecordControllers(vrState.controllers, &vrState.headset);
 }
 
 // =============================================================================
-// Public API Implementation
+// Frame Statistics
 // =============================================================================
 
-bool InitApp(struct android_app* app) {
-    LOGI("InitApp starting...");
-    
-    memset(&vrState, 0, sizeof(vrState));
-    vrState.app = app;
-    vrState.clearColor = (Color){30, 30, 50, 255};  // Dark blue default
-    
-    // Initialize EGL
-    if (!InitializeEGL()) {
-        LOGE("Failed to initialize EGL");
-        return false;
+// GPU results arrive a few frames late; one query per in-flight frame
+#define GPU_QUERY_LATENCY 4
+
+typedef struct {
+    VRFrameStats history[VR_FRAME_STATS_HISTORY];   // Indexed by frame % history
+    uint64_t frameCounter;                          // Frames committed so far
+    uint64_t windowStart;                           // First frame the reductions cover
+    pthread_mutex_t lock;                           // History is committed on the render thread
+    double appStart;
+    
+    // GL_EXT_disjoint_timer_query
+    bool gpuTimerSupported;
+    GLuint gpuQueries[GPU_QUERY_LATENCY];
+    uint64_t gpuQueryFrame[GPU_QUERY_LATENCY];
+    bool gpuQueryPending[GPU_QUERY_LATENCY];
+    PFNGLGETQUERYOBJECTUI64VEXTPROC glGetQueryObjectui64vEXT;
+} FrameStatsRing;
+
+static FrameStatsRing frameStats = {0};
+
+static void ResetFrameStats(RenderFrame* frame) {
+    memset(&frame->stats, 0, sizeof(frame->stats));
+    frame->stats.gpuMs = -1.0f;   // Filled in when the query resolves
+    frame->stats.resolutionScale = -1.0f;   // Set if the frame renders
+    frame->frameStart = GetTimeMs();
+}
+
+static void InitFrameStats(void) {
+    memset(&frameStats, 0, sizeof(frameStats));
+    pthread_mutex_init(&frameStats.lock, NULL);
+    
+    const char* glExtensions = (const char*)glGetString(GL_EXTENSIONS);
+    if (glExtensions != NULL && strstr(glExtensions, "GL_EXT_disjoint_timer_query") != NULL) {
+        frameStats.glGetQueryObjectui64vEXT = (PFNGLGETQUERYOBJECTUI64VEXTPROC)
+            eglGetProcAddress("glGetQueryObjectui64vEXT");
     }
     
-    // Initialize OpenXR
-    if (!InitializeOpenXR()) {
-        LOGE("Failed to initialize OpenXR");
-        ShutdownEGL();
-        return false;
+    frameStats.gpuTimerSupported = (frameStats.glGetQueryObjectui64vEXT != NULL);
+    if (frameStats.gpuTimerSupported) {
+        glGenQueries(GPU_QUERY_LATENCY, frameStats.gpuQueries);
+        
+        // Reading the disjoint flag clears it before the first query
+        GLint disjoint = 0;
+        glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
     }
-    
-    // Create session
-    if (!CreateSession()) {
-        LOGE("Failed to create session");
-        ShutdownOpenXR();
-        ShutdownEGL();
-        return false;
+    LOGI("GPU frame timing: %s", frameStats.gpuTimerSupported ? "GL_EXT_disjoint_timer_query" : "unavailable");
+}
+
+// Steer dynamic resolution from a resolved GPU time. Results still in flight
+// from before the last change were rendered at an older scale and would
+// push it again for the same load, so only frames at the current scale count
+static void UpdateResolutionScale(float gpuMs, float renderedScale, uint64_t frame) {
+    if (!(vrConfigFlags & FLAG_VR_DYNAMIC_RESOLUTION) || gpuMs <= 0.0f || renderedScale <= 0.0f) return;
+    if (frame < vrState.resolutionScaleFrame) return;
+    
+    float scale = NextResolutionScale(gpuMs, renderedScale);
+    if (scale == vrState.resolutionScale) return;
+    
+    // This frame already has its size; the new scale applies from the next
+    pthread_mutex_lock(&frameStats.lock);
+    vrState.resolutionScale = scale;
+    pthread_mutex_unlock(&frameStats.lock);
+    vrState.resolutionScaleFrame = frameStats.frameCounter + 1;
+}
+
+// Collect a finished GPU query into the history entry of the frame that issued it
+static void ResolveGpuQuery(int slot) {
+    if (!frameStats.gpuQueryPending[slot]) return;
+    
+    GLuint available = 0;
+    glGetQueryObjectuiv(frameStats.gpuQueries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) return;
+    frameStats.gpuQueryPending[slot] = false;
+    
+    // A disjoint event (e.g. frequency change) makes in-flight results meaningless
+    GLint disjoint = 0;
+    glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+    if (disjoint) return;
+    
+    GLuint64 elapsedNs = 0;
+    frameStats.glGetQueryObjectui64vEXT(frameStats.gpuQueries[slot], GL_QUERY_RESULT, &elapsedNs);
+    
+    // The first frame carries driver warm-up (and bogus timestamps on some drivers)
+    uint64_t frame = frameStats.gpuQueryFrame[slot];
+    if (frame == 0) return;
+    
+    float gpuMs = (float)(elapsedNs / 1000000.0);
+    float renderedScale = -1.0f;
+    if (frame == frameStats.frameCounter) {
+        renderFrame->stats.gpuMs = gpuMs;
+        renderedScale = renderFrame->stats.resolutionScale;
+    } else if (frameStats.frameCounter - frame <= VR_FRAME_STATS_HISTORY) {
+        pthread_mutex_lock(&frameStats.lock);
+        frameStats.history[frame % VR_FRAME_STATS_HISTORY].gpuMs = gpuMs;
+        renderedScale = frameStats.history[frame % VR_FRAME_STATS_HISTORY].resolutionScale;
+        pthread_mutex_unlock(&frameStats.lock);
     }
-    
-    vrState.initialized = true;
-    LOGI("InitApp completed successfully");
-    return true;
+    UpdateResolutionScale(gpuMs, renderedScale, frame);
 }
 
-void CloseApp(struct android_app* app) {
-    LOGI("CloseApp starting...");
+static void BeginGpuTimer(void) {
+    if (!frameStats.gpuTimerSupported) return;
     
+    int slot = (int)(frameStats.frameCounter % GPU_QUERY_LATENCY);
+    ResolveGpuQuery(slot);
+    
+    glBeginQuery(GL_TIME_ELAPSED_EXT, frameStats.gpuQueries[slot]);
+    frameStats.gpuQueryFrame[slot] = frameStats.frameCounter;
+    frameStats.gpuQueryPending[slot] = true;
+}
+
+static void EndGpuTimer(void) {
+    if (!frameStats.gpuTimerSupported) return;
+    
+    glEndQuery(GL_TIME_ELAPSED_EXT);
+    
+    // Pick up any other results that are ready without waiting
+    for (int slot = 0; slot < GPU_QUERY_LATENCY; slot++) {
+        ResolveGpuQuery(slot);
+    }
+}
+
+static void CommitFrameStats(void) {
+    renderFrame->stats.frameMs = (float)(GetTimeMs() - renderFrame->frameStart);
+    pthread_mutex_lock(&frameStats.lock);
+    frameStats.history[frameStats.frameCounter % VR_FRAME_STATS_HISTORY] = renderFrame->stats;
+    frameStats.frameCounter++;
+    pthread_mutex_unlock(&frameStats.lock);
+}
+
+static int GetFrameStatsCount(void) {
+    uint64_t frames = frameStats.frameCounter - frameStats.windowStart;
+    return (frames < VR_FRAME_STATS_HISTORY) ? (int)frames : VR_FRAME_STATS_HISTORY;
+}
+
+static int CompareFloats(const void* a, const void* b) {
+    float fa = *(const float*)a;
+    float fb = *(const float*)b;
+    return (fa > fb) - (fa < fb);
+}
+
+// Reduce every field of the history independently. Negative values mark
+// missing samples (GPU time not available yet) and are skipped.
+typedef enum { STATS_MIN, STATS_AVG, STATS_P99 } StatsReduction;
+
+static VRFrameStats ReduceFrameStats(StatsReduction reduction) {
+    VRFrameStats result = {0};
+    pthread_mutex_lock(&frameStats.lock);
+    int count = GetFrameStatsCount();
+    int fieldCount = sizeof(VRFrameStats) / sizeof(float);
+    float values[VR_FRAME_STATS_HISTORY];
+    
+    for (int f = 0; f < fieldCount; f++) {
+        int n = 0;
+        for (int i = 0; i < count; i++) {
+            uint64_t frame = frameStats.frameCounter - count + i;
+            float v = ((const float*)&frameStats.history[frame % VR_FRAME_STATS_HISTORY])[f];
+            if (v >= 0.0f) values[n++] = v;
+        }
+        
+        float r = -1.0f;
+        if (n > 0) {
+            if (reduction == STATS_AVG) {
+                double sum = 0.0;
+                for (int i = 0; i < n; i++) sum += values[i];
+                r = (float)(sum / n);
+            } else {
+                qsort(values, n, sizeof(float), CompareFloats);
+                r = (reduction == STATS_MIN) ? values[0] : values[(int)ceilf(0.99f * n) - 1];
+            }
+        }
+        ((float*)&result)[f] = r;
+    }
+    pthread_mutex_unlock(&frameStats.lock);
+    return result;
+}
+
+// =============================================================================
+// Render Thread (FLAG_VR_THREADED_RENDER)
+// =============================================================================
+
+// The render thread owns the EGL context. While it begins, renders and ends
+// frame N, the app thread waits for, simulates and records frame N+1 into
+// the other command arena. xrWaitFrame stays on the app thread; at most one
+// frame is in flight, so the app never runs more than one frame ahead
+typedef struct {
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    bool running;
+    bool busy;              // A frame was handed over and is not submitted yet
+    bool quit;
+    RenderFrame frame;      // Copy of the frame being rendered
+} RenderThread;
+
+static RenderThread renderThread = {0};
+
+static void* RenderThreadMain(void* arg) {
+    (void)arg;
+    eglMakeCurrent(vrState.eglDisplay, vrState.eglSurface, vrState.eglSurface, vrState.eglContext);
+    
+    pthread_mutex_lock(&renderThread.mutex);
+    while (true) {
+        while (!renderThread.busy && !renderThread.quit) {
+            pthread_cond_wait(&renderThread.cond, &renderThread.mutex);
+        }
+        // A frame queued before the quit request is still submitted
+        if (!renderThread.busy) break;
+        pthread_mutex_unlock(&renderThread.mutex);
+        
+        BeginXrFrame();
+        RenderRecordedFrame();
+        
+        pthread_mutex_lock(&renderThread.mutex);
+        renderThread.busy = false;
+        pthread_cond_broadcast(&renderThread.cond);
+    }
+    pthread_mutex_unlock(&renderThread.mutex);
+    
+    eglMakeCurrent(vrState.eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    return NULL;
+}
+
+// Block until the frame in flight has been submitted
+static void WaitForRenderThread(void) {
+    if (!renderThread.running) return;
+    
+    pthread_mutex_lock(&renderThread.mutex);
+    while (renderThread.busy) {
+        pthread_cond_wait(&renderThread.cond, &renderThread.mutex);
+    }
+    pthread_mutex_unlock(&renderThread.mutex);
+}
+
+// Hand the recorded frame over. Returns as soon as the previous frame has
+// been submitted, so the app can start on the next one
+static void QueueRenderThreadFrame(void) {
+    pthread_mutex_lock(&renderThread.mutex);
+    while (renderThread.busy) {
+        pthread_cond_wait(&renderThread.cond, &renderThread.mutex);
+    }
+    
+    renderThread.frame = vrState.frame;
+    
+    // Without an app update the thread re-renders the arena it already has
+    if (vrState.updateThisFrame) {
+        DrawCommandArena* recorded = recordArena;
+        recordArena = renderArena;
+        renderArena = recorded;
+    }
+    
+    renderThread.busy = true;
+    pthread_cond_broadcast(&renderThread.cond);
+    pthread_mutex_unlock(&renderThread.mutex);
+}
+
+static bool StartRenderThread(void) {
+    pthread_mutex_init(&renderThread.mutex, NULL);
+    pthread_cond_init(&renderThread.cond, NULL);
+    renderThread.busy = false;
+    renderThread.quit = false;
+    
+    recordArena = &drawArenas[1];
+    renderArena = &drawArenas[0];
+    renderFrame = &renderThread.frame;
+    
+    // A context can only be current on one thread at a time
+    eglMakeCurrent(vrState.eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    
+    if (pthread_create(&renderThread.thread, NULL, RenderThreadMain, NULL) != 0) {
+        LOGE("Failed to create render thread, rendering on the app thread");
+        eglMakeCurrent(vrState.eglDisplay, vrState.eglSurface, vrState.eglSurface, vrState.eglContext);
+        recordArena = renderArena = &drawArenas[0];
+        renderFrame = &vrState.frame;
+        pthread_cond_destroy(&renderThread.cond);
+        pthread_mutex_destroy(&renderThread.mutex);
+        return false;
+    }
+    
+    renderThread.running = true;
+    LOGI("Render thread started");
+    return true;
+}
+
+static void StopRenderThread(void) {
+    if (!renderThread.running) return;
+    
+    pthread_mutex_lock(&renderThread.mutex);
+    renderThread.quit = true;
+    pthread_cond_broadcast(&renderThread.cond);
+    pthread_mutex_unlock(&renderThread.mutex);
+    
+    pthread_join(renderThread.thread, NULL);
+    pthread_cond_destroy(&renderThread.cond);
+    pthread_mutex_destroy(&renderThread.mutex);
+    renderThread.running = false;
+    
+    // Back to single-threaded, so shutdown can release GL objects here
+    eglMakeCurrent(vrState.eglDisplay, vrState.eglSurface, vrState.eglSurface, vrState.eglContext);
+    recordArena = renderArena = &drawArenas[0];
+    renderFrame = &vrState.frame;
+    LOGI("Render thread stopped");
+}
+
+// =============================================================================
+// Public API Implementation
+// =============================================================================
+
+bool InitApp(struct android_app* app) {
+    LOGI("InitApp starting...");
+    
+    memset(&vrState, 0, sizeof(vrState));
+    vrState.app = app;
+    vrState.clearColor = (Color){30, 30, 50, 255};  // Dark blue default
+    
+    // Initialize EGL
+    if (!InitializeEGL()) {
+        LOGE("Failed to initialize EGL");
+        return false;
+    }
+    
+    // Initialize OpenXR
+    if (!InitializeOpenXR()) {
+        LOGE("Failed to initialize OpenXR");
+        ShutdownEGL();
+        return false;
+    }
+    
+    // Create session
+    if (!CreateSession()) {
+        LOGE("Failed to create session");
+        ShutdownOpenXR();
+        ShutdownEGL();
+        return false;
+    }
+    
+    // Shaders and static geometry are built once the GL context and
+    // swapchains (which decide multiview) exist
+    InitShaders();
+    InitMeshGeometry();
+    InitLineGeometry();
+    InitHandRenderer();
+    InitTextRenderer();
+    glCache = (GLStateCache){ 0, 0, -1, 0, 0 };
+    InitFrameStats();
+    
+    if (vrConfigFlags & FLAG_VR_THREADED_RENDER) {
+        StartRenderThread();
+    }
+    
+    vrState.initialized = true;
+    LOGI("InitApp completed successfully");
+    return true;
+}
+
+void CloseApp(struct android_app* app) {
+    LOGI("CloseApp starting...");
+    
+    StopRenderThread();
+    StopInputRecording();
+    StopInputPlayback();
     DestroySession();
     ShutdownOpenXR();
     ShutdownEGL();
+    FreeDrawCommands();
     
     vrState.initialized = false;
     LOGI("CloseApp completed");
 }
 
 bool AppShouldClose(struct android_app* app) {
+    // XR events first, so a session that just became ready renders this frame
+    PollXREvents();
+    
+    // With no session running there is nothing to render, so block on the
+    // looper instead of spinning. XR events do not wake the looper; the
+    // timeout bounds how late a state change is noticed
+    bool idle = !vrState.sessionRunning && !vrState.shouldExit && !app->destroyRequested;
+    int timeoutMs = idle ? VR_IDLE_POLL_TIMEOUT_MS : 0;
+    
     // Poll Android events using ALooper_pollOnce (ALooper_pollAll is deprecated)
     int events;
     struct android_poll_source* source;
     
-    while (ALooper_pollOnce(0, NULL, &events, (void**)&source) >= 0) {
+    while (ALooper_pollOnce(timeoutMs, NULL, &events, (void**)&source) >= 0) {
         if (source != NULL) {
             source->process(app, source);
         }
         if (app->destroyRequested) {
             vrState.shouldExit = true;
         }
+        timeoutMs = 0;  // Drain the rest without blocking
     }
     
-    // Poll XR events
-    PollXREvents();
+    if (idle) {
+        PollXREvents();
+    }
     
     return vrState.shouldExit;
 }
 
+bool IsVRSessionFocused(void) {
+    return vrState.sessionFocused;
+}
+
+bool ShouldUpdateThisFrame(void) {
+    return vrState.sessionRunning && vrState.updateThisFrame;
+}
+
+float GetFrameTime(void) {
+    return (vrState.frameTime > 0.0f) ? vrState.frameTime : VR_DEFAULT_FRAME_TIME;
+}
+
+float GetPredictedDisplayPeriod(void) {
+    return (vrState.predictedDisplayPeriod > 0) ? NanosecondsToSeconds(vrState.predictedDisplayPeriod) : VR_DEFAULT_FRAME_TIME;
+}
+
+int GetMissedFrameCount(void) {
+    return vrState.missedFrames;
+}
+
+bool ShouldRenderThisFrame(void) {
+    return vrState.sessionRunning && vrState.frame.shouldRender;
+}
+
+static void UpdateFrameTiming(XrTime appDisplayTime) {
+    XrDuration period = vrState.predictedDisplayPeriod;
+    
+    // Display times sit on the refresh grid, so a gap of more than one
+    // period between consecutive frames means the runtime dropped frames
+    if (vrState.lastDisplayTime != 0 && period > 0) {
+        XrDuration gap = vrState.predictedDisplayTime - vrState.lastDisplayTime;
+        int missed = (int)((gap + period / 2) / period) - 1;
+        if (missed > 0) {
+            vrState.missedFrames += missed;
+        }
+    }
+    vrState.lastDisplayTime = vrState.predictedDisplayTime;
+    if (period > 0) {
+        vrState.headset.displayRefreshRate = 1.0f / NanosecondsToSeconds(period);
+    }
+    
+    if (!vrState.updateThisFrame) return;
+    
+    // Step between the app's updates (one per frame unless unfocused)
+    float step = (period > 0) ? NanosecondsToSeconds(period) : VR_DEFAULT_FRAME_TIME;
+    if (vrState.lastUpdateDisplayTime != 0) {
+        float elapsed = NanosecondsToSeconds(appDisplayTime - vrState.lastUpdateDisplayTime);
+        if (elapsed > 0.0f) {
+            step = (elapsed < VR_MAX_FRAME_TIME) ? elapsed : VR_MAX_FRAME_TIME;
+        }
+    }
+    vrState.frameTime = step;
+    vrState.lastUpdateDisplayTime = appDisplayTime;
+}
+
 void BeginVRMode(void) {
-    if (!vrState.sessionRunning) return;
+    if (!vrState.sessionRunning) {
+        vrState.updateThisFrame = false;
+        return;
+    }
+    
+    ResetFrameStats(&vrState.frame);
+    
+    // Visible but unfocused (a system menu has input): the app only updates
+    // every few frames, and the frames in between re-render its last commands
+    if (vrState.sessionFocused) {
+        vrState.unfocusedFrames = 0;
+        vrState.updateThisFrame = true;
+    } else {
+        vrState.updateThisFrame = (vrState.unfocusedFrames++ % VR_UNFOCUSED_UPDATE_INTERVAL) == 0;
+    }
     
     // Clear the draw command buffer for this frame
-    ClearDrawCommands();
+    if (vrState.updateThisFrame) {
+        ClearDrawCommands();
+    }
     
     // Wait for frame
     XrFrameWaitInfo waitInfo = {
@@ -1300,15 +2559,22 @@ void BeginVRMode(void) {
         .next = NULL
     };
     
+    double waitStart = GetTimeMs();
     xrWaitFrame(vrState.session, &waitInfo, &frameState);
+    vrState.frame.stats.waitFrameMs = (float)(GetTimeMs() - waitStart);
     vrState.predictedDisplayTime = frameState.predictedDisplayTime;
+    vrState.predictedDisplayPeriod = frameState.predictedDisplayPeriod;
+    vrState.frame.displayTime = frameState.predictedDisplayTime;
+    vrState.frame.shouldRender = frameState.shouldRender;
     
-    // Begin frame
-    XrFrameBeginInfo beginInfo = {
-        .type = XR_TYPE_FRAME_BEGIN_INFO,
-        .next = NULL
-    };
-    xrBeginFrame(vrState.session, &beginInfo);
+    // Culling compacts the streams, so it is skipped while unfocused frames
+    // may re-render the same commands from a different head pose
+    vrState.frame.cull = vrState.sessionFocused;
+    
+    // The render thread begins the frames it renders itself
+    if (!renderThread.running) {
+        BeginXrFrame();
+    }
     
     // Get views
     XrViewLocateInfo locateInfo = {
@@ -1324,55 +2590,170 @@ void BeginVRMode(void) {
         .next = NULL
     };
     
+    XrView* views = vrState.frame.views;
     for (uint32_t i = 0; i < vrState.viewCount; i++) {
-        vrState.views[i].type = XR_TYPE_VIEW;
-        vrState.views[i].next = NULL;
+        views[i].type = XR_TYPE_VIEW;
+        views[i].next = NULL;
     }
     
     uint32_t viewCount = 0;
-    xrLocateViews(vrState.session, &locateInfo, &viewState, vrState.viewCount, &viewCount, vrState.views);
+    xrLocateViews(vrState.session, &locateInfo, &viewState, vrState.viewCount, &viewCount, views);
+    
+    // Recorded eye poses (and display times) replace the runtime's during playback
+    XrTime appDisplayTime = vrState.predictedDisplayTime;
+    if (!PlaybackFrameViews(&appDisplayTime, views, viewCount)) {
+        RecordFrameViews(vrState.predictedDisplayTime, views, viewCount);
+    }
+    UpdateFrameTiming(appDisplayTime);
     
     // Update headset eye data
     for (uint32_t i = 0; i < viewCount && i < 2; i++) {
-        Matrix proj = CreateProjectionMatrix(vrState.views[i].fov, 0.01f, 100.0f);
-        Matrix view = CreateViewMatrix(vrState.views[i].pose);
+        Matrix proj = CreateProjectionMatrix(views[i].fov, 0.01f, 100.0f);
+        Matrix view = CreateViewMatrix(views[i].pose);
+        
+        // View-projection consumed by the shaders (per eye, or both at once in multiview)
+        MatrixToFloatArray(MatrixMultiply(view, proj), vrState.frame.viewProj[i]);
+        vrState.frame.eyeWorldPosition[i] = TrackingToWorld(views[i].pose.position);
+        vrState.frame.eyeFocalPixels[i] = vrState.viewConfig[i].recommendedImageRectWidth /
+            (tanf(views[i].fov.angleRight) - tanf(views[i].fov.angleLeft));
         
         if (i == 0) {
             vrState.headset.leftEyeProjection = proj;
             vrState.headset.leftEyeView = view;
             vrState.headset.leftEyePosition = (Vector3){
-                vrState.views[i].pose.position.x,
-                vrState.views[i].pose.position.y,
-                vrState.views[i].pose.position.z
+                views[i].pose.position.x,
+                views[i].pose.position.y,
+                views[i].pose.position.z
             };
         } else {
             vrState.headset.rightEyeProjection = proj;
             vrState.headset.rightEyeView = view;
             vrState.headset.rightEyePosition = (Vector3){
-                vrState.views[i].pose.position.x,
-                vrState.views[i].pose.position.y,
-                vrState.views[i].pose.position.z
+                views[i].pose.position.x,
+                views[i].pose.position.y,
+                views[i].pose.position.z
             };
         }
     }
     
     vrState.headset.displayWidth = vrState.viewConfig[0].recommendedImageRectWidth;
     vrState.headset.displayHeight = vrState.viewConfig[0].recommendedImageRectHeight;
+    
+    // Everything until EndVRMode is the app's frame (input sync, inLoop, draw calls)
+    frameStats.appStart = GetTimeMs();
 }
 
-void EndVRMode(void) {
-    if (!vrState.sessionRunning) return;
+// Keep the poses this frame's attached draws were placed with. Recorded
+// poses are not re-located during playback, where they must stay as recorded
+static void StoreDrawSpacePoses(void) {
+    const VRController* controllers = vrState.controllers;
+    const VRHeadset* headset = &vrState.headset;
+    bool live = !IsInputPlaybackActive();
+    
+    for (int hand = 0; hand < 2; hand++) {
+        int space = (hand == CONTROLLER_LEFT) ? VR_SPACE_LEFT_CONTROLLER : VR_SPACE_RIGHT_CONTROLLER;
+        vrState.frame.spacePoses[space] = (XrPosef){
+            { controllers[hand].orientation.x, controllers[hand].orientation.y,
+              controllers[hand].orientation.z, controllers[hand].orientation.w },
+            { controllers[hand].position.x, controllers[hand].position.y, controllers[hand].position.z }
+        };
+        vrState.frame.spaceTracked[space] = live && controllers[hand].isTracking;
+    }
+    
+    vrState.frame.spacePoses[VR_SPACE_HEAD] = (XrPosef){
+        { headset->orientation.x, headset->orientation.y, headset->orientation.z, headset->orientation.w },
+        { headset->position.x, headset->position.y, headset->position.z }
+    };
+    vrState.frame.spaceTracked[VR_SPACE_HEAD] = live;
+    vrState.frame.spaceTracked[VR_SPACE_WORLD] = false;
+}
+
+// Late latch: locate the attached spaces again, as close to rendering as
+// possible, and store how far each moved since the app drew with it
+static void LatchDrawSpaces(void) {
+    XrSpace spaces[VR_SPACE_COUNT] = {
+        XR_NULL_HANDLE, vrState.leftHandSpace, vrState.rightHandSpace, vrState.headSpace
+    };
+    const XrSpaceLocationFlags valid = XR_SPACE_LOCATION_POSITION_VALID_BIT | XR_SPACE_LOCATION_ORIENTATION_VALID_BIT;
+    
+    for (int s = 0; s < VR_SPACE_COUNT; s++) {
+        Matrix correction = MatrixIdentity();
+        if (renderFrame->spaceTracked[s]) {
+            XrSpaceLocation location = {
+                .type = XR_TYPE_SPACE_LOCATION,
+                .next = NULL
+            };
+            xrLocateSpace(spaces[s], vrState.stageSpace, renderFrame->displayTime, &location);
+            if ((location.locationFlags & valid) == valid) {
+                correction = PoseCorrectionMatrix(renderFrame->spacePoses[s], location.pose);
+            }
+        }
+        MatrixToFloatArray(correction, drawSpaceCorrection[s]);
+    }
+}
+
+// Every xrBeginFrame needs a matching xrEndFrame, even with no layers
+static void SubmitFrame(const XrCompositionLayerBaseHeader* const* layers, uint32_t layerCount) {
+    XrFrameEndInfo endInfo = {
+        .type = XR_TYPE_FRAME_END_INFO,
+        .next = NULL,
+        .displayTime = renderFrame->displayTime,
+        .environmentBlendMode = XR_ENVIRONMENT_BLEND_MODE_OPAQUE,
+        .layerCount = layerCount,
+        .layers = layers
+    };
+    
+    double endFrameStart = GetTimeMs();
+    xrEndFrame(vrState.session, &endInfo);
+    renderFrame->stats.endFrameMs = (float)(GetTimeMs() - endFrameStart);
     
+    CommitFrameStats();
+}
+
+static void BeginXrFrame(void) {
+    XrFrameBeginInfo beginInfo = {
+        .type = XR_TYPE_FRAME_BEGIN_INFO,
+        .next = NULL
+    };
+    xrBeginFrame(vrState.session, &beginInfo);
+}
+
+// Cull, render and submit renderFrame from renderArena. Called by EndVRMode,
+// or by the render thread one frame behind the app
+static void RenderRecordedFrame(void) {
     XrCompositionLayerProjectionView projectionViews[MAX_VIEWS] = {0};
     
-    for (uint32_t i = 0; i < vrState.viewCount; i++) {
+    double submitStart = GetTimeMs();
+    glCache.drawCalls = 0;
+    glCache.stateChanges = 0;
+    
+    // The runtime will not display this frame: skip all GPU work
+    if (!renderFrame->shouldRender) {
+        renderArena->drawCalls = 0;
+        renderArena->stateChanges = 0;
+        SubmitFrame(NULL, 0);
+        return;
+    }
+    
+    // Cull, batch and upload the recorded commands once, shared by both eyes
+    if (renderFrame->cull) {
+        CullDrawCommands();
+    }
+    UploadDrawStreams();
+    ApplyResolutionScale();
+    renderFrame->stats.prepareMs = (float)(GetTimeMs() - submitStart);
+    
+    BeginGpuTimer();
+    
+    // Multiview renders both eyes into one array swapchain in a single pass
+    for (uint32_t s = 0; s < vrState.swapchainCount; s++) {
         // Acquire swapchain image
         XrSwapchainImageAcquireInfo acquireInfo = {
             .type = XR_TYPE_SWAPCHAIN_IMAGE_ACQUIRE_INFO,
             .next = NULL
         };
         uint32_t imageIndex;
-        xrAcquireSwapchainImage(vrState.swapchain[i], &acquireInfo, &imageIndex);
+        xrAcquireSwapchainImage(vrState.swapchain[s], &acquireInfo, &imageIndex);
         
         // Wait for image
         XrSwapchainImageWaitInfo waitInfo = {
@@ -1380,34 +2761,64 @@ void EndVRMode(void) {
             .next = NULL,
             .timeout = XR_INFINITE_DURATION
         };
-        xrWaitSwapchainImage(vrState.swapchain[i], &waitInfo);
+        xrWaitSwapchainImage(vrState.swapchain[s], &waitInfo);
         
-        // Render to this eye
-        vrState.currentEye = i;
-        vrState.currentViewMatrix = (i == 0) ? vrState.headset.leftEyeView : vrState.headset.rightEyeView;
-        vrState.currentProjectionMatrix = (i == 0) ? vrState.headset.leftEyeProjection : vrState.headset.rightEyeProjection;
+        // The image wait can block, so poses are latched after it
+        if (s == 0) {
+            LatchDrawSpaces();
+            UploadViewUniforms();
+        }
         
-        RenderEye(i, imageIndex);
+        double eyeStart = GetTimeMs();
+        if (vrState.multiview) {
+            RenderMultiview(imageIndex);
+        } else {
+            // Render to this eye
+            vrState.currentEye = s;
+            RenderEye(s, imageIndex);
+        }
+        renderFrame->stats.eyeMs[s] = (float)(GetTimeMs() - eyeStart);
         
         // Release swapchain image
         XrSwapchainImageReleaseInfo releaseInfo = {
             .type = XR_TYPE_SWAPCHAIN_IMAGE_RELEASE_INFO,
             .next = NULL
         };
-        xrReleaseSwapchainImage(vrState.swapchain[i], &releaseInfo);
-        
-        // Set up projection view
+        xrReleaseSwapchainImage(vrState.swapchain[s], &releaseInfo);
+    }
+    
+    EndGpuTimer();
+    renderArena->drawCalls = glCache.drawCalls;
+    renderArena->stateChanges = glCache.stateChanges;
+    
+    // Set up projection views (array layer per eye in multiview)
+    for (uint32_t i = 0; i < vrState.viewCount; i++) {
         projectionViews[i].type = XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW;
         projectionViews[i].next = NULL;
-        projectionViews[i].pose = vrState.views[i].pose;
-        projectionViews[i].fov = vrState.views[i].fov;
-        projectionViews[i].subImage.swapchain = vrState.swapchain[i];
+        projectionViews[i].pose = renderFrame->views[i].pose;
+        projectionViews[i].fov = renderFrame->views[i].fov;
+        projectionViews[i].subImage.swapchain = vrState.multiview ? vrState.swapchain[0] : vrState.swapchain[i];
         projectionViews[i].subImage.imageRect.offset = (XrOffset2Di){0, 0};
         projectionViews[i].subImage.imageRect.extent = (XrExtent2Di){
-            vrState.viewConfig[i].recommendedImageRectWidth,
-            vrState.viewConfig[i].recommendedImageRectHeight
+            vrState.renderWidth[i],
+            vrState.renderHeight[i]
         };
-        projectionViews[i].subImage.imageArrayIndex = 0;
+        projectionViews[i].subImage.imageArrayIndex = vrState.multiview ? i : 0;
+    }
+    
+    // CPU submit cost, logged periodically so both stereo paths can be compared
+    float submitTimeMs = (float)(GetTimeMs() - submitStart);
+    pthread_mutex_lock(&frameStats.lock);
+    vrState.submitTimeMs = submitTimeMs;
+    pthread_mutex_unlock(&frameStats.lock);
+    static double submitTimeAccum = 0.0;
+    static int submitFrames = 0;
+    submitTimeAccum += submitTimeMs;
+    if (++submitFrames == 100) {
+        LOGD("Render submit (%s): %.3f ms CPU avg over %d frames",
+            vrState.multiview ? "multiview" : "two-pass", submitTimeAccum / submitFrames, submitFrames);
+        submitTimeAccum = 0.0;
+        submitFrames = 0;
     }
     
     // Submit frame
@@ -1424,22 +2835,115 @@ void EndVRMode(void) {
         (XrCompositionLayerBaseHeader*)&projectionLayer
     };
     
-    XrFrameEndInfo endInfo = {
-        .type = XR_TYPE_FRAME_END_INFO,
-        .next = NULL,
-        .displayTime = vrState.predictedDisplayTime,
-        .environmentBlendMode = XR_ENVIRONMENT_BLEND_MODE_OPAQUE,
-        .layerCount = 1,
-        .layers = layers
-    };
+    SubmitFrame(layers, 1);
+}
+
+void EndVRMode(void) {
+    if (!vrState.sessionRunning) return;
     
-    xrEndFrame(vrState.session, &endInfo);
+    vrState.frame.stats.appMs = (float)(GetTimeMs() - frameStats.appStart);
+    vrState.drawSpace = VR_SPACE_WORLD;
+    if (vrState.updateThisFrame) {
+        StoreDrawSpacePoses();
+    }
+    RecordFrameEnd();
+    
+    if (renderThread.running) {
+        QueueRenderThreadFrame();
+    } else {
+        RenderRecordedFrame();
+    }
+}
+
+void BeginVRDrawSpace(VRDrawSpace space) {
+    if (space < VR_SPACE_WORLD || space >= VR_SPACE_COUNT) return;
+    vrState.drawSpace = space;
+}
+
+void EndVRDrawSpace(void) {
+    vrState.drawSpace = VR_SPACE_WORLD;
 }
 
 void SetVRClearColor(Color color) {
     vrState.clearColor = color;
 }
 
+void SetVRConfigFlags(unsigned int flags) {
+    vrConfigFlags = flags;
+}
+
+void SetVRResolutionScaleRange(float minScale, float maxScale) {
+    if (minScale <= 0.0f || maxScale < minScale) return;
+    vrResolutionScaleMin = minScale;
+    vrResolutionScaleMax = maxScale;
+}
+
+float GetVRResolutionScale(void) {
+    pthread_mutex_lock(&frameStats.lock);
+    float scale = vrState.resolutionScale;
+    pthread_mutex_unlock(&frameStats.lock);
+    return scale;
+}
+
+bool IsVRMultiviewEnabled(void) {
+    return vrState.multiview;
+}
+
+int GetVRMSAASamples(void) {
+    return vrState.msaaSamples;
+}
+
+bool IsVRRenderThreadEnabled(void) {
+    return renderThread.running;
+}
+
+float GetVRRenderSubmitTime(void) {
+    pthread_mutex_lock(&frameStats.lock);
+    float submitTimeMs = vrState.submitTimeMs;
+    pthread_mutex_unlock(&frameStats.lock);
+    return submitTimeMs;
+}
+
+VRDrawStats GetVRDrawStats(void) {
+    return drawStats;
+}
+
+VRFrameStats GetVRFrameStats(void) {
+    VRFrameStats stats = {0};
+    pthread_mutex_lock(&frameStats.lock);
+    if (frameStats.frameCounter > 0) {
+        stats = frameStats.history[(frameStats.frameCounter - 1) % VR_FRAME_STATS_HISTORY];
+    }
+    pthread_mutex_unlock(&frameStats.lock);
+    return stats;
+}
+
+int GetVRFrameStatsCount(void) {
+    pthread_mutex_lock(&frameStats.lock);
+    int count = GetFrameStatsCount();
+    pthread_mutex_unlock(&frameStats.lock);
+    return count;
+}
+
+VRFrameStats GetVRFrameStatsMin(void) {
+    return ReduceFrameStats(STATS_MIN);
+}
+
+VRFrameStats GetVRFrameStatsAvg(void) {
+    return ReduceFrameStats(STATS_AVG);
+}
+
+VRFrameStats GetVRFrameStatsP99(void) {
+    return ReduceFrameStats(STATS_P99);
+}
+
+void ResetVRFrameStats(void) {
+    // GPU results still in flight land in slots outside the new window
+    pthread_mutex_lock(&frameStats.lock);
+    frameStats.windowStart = frameStats.frameCounter;
+    pthread_mutex_unlock(&frameStats.lock);
+}
+
 void SyncControllers(void) {
     UpdateInput();
 }
@@ -1541,27 +3045,79 @@ bool IsPlayerGrounded(float groundHeight) {
 // Rendering Implementation
 // =============================================================================
 
-// Simple shader programs (embedded source)
-static const char* vertexShaderSource = 
+// Vertex shader preambles: the same body is compiled for two-pass (one view per
+// draw) or single-pass multiview (VIEW_ID selects the eye's view-projection).
+// uDrawSpace holds the late-latch correction per VRDrawSpace
+static const char* vertexHeaderTwoPass = 
+    "#version 300 es\n"
+    "#define NUM_VIEWS 1\n"
+    "#define VIEW_ID 0\n"
+    "layout(std140) uniform ViewBlock { mat4 uViewProj[NUM_VIEWS]; mat4 uDrawSpace[4]; };\n";
+
+static const char* vertexHeaderMultiview = 
     "#version 300 es\n"
+    "#extension GL_OVR_multiview2 : require\n"
+    "layout(num_views = 2) in;\n"
+    "#define NUM_VIEWS 2\n"
+    "#define VIEW_ID gl_ViewID_OVR\n"
+    "layout(std140) uniform ViewBlock { mat4 uViewProj[NUM_VIEWS]; mat4 uDrawSpace[4]; };\n";
+
+// Simple shader programs (embedded source), used for batched lines
+static const char* vertexShaderSource = 
     "layout(location = 0) in vec3 aPosition;\n"
-    "uniform mat4 uMVP;\n"
+    "layout(location = 1) in vec4 aColor;\n"
+    "layout(location = 2) in float aSpace;\n"
+    "out vec3 vColor;\n"
     "void main() {\n"
-    "    gl_Position = uMVP * vec4(aPosition, 1.0);\n"
+    "    vColor = aColor.rgb;\n"
+    "    gl_Position = uViewProj[VIEW_ID] * uDrawSpace[int(aSpace)] * vec4(aPosition, 1.0);\n"
     "}\n";
 
 static const char* fragmentShaderSource = 
     "#version 300 es\n"
     "precision mediump float;\n"
-    "uniform vec4 uColor;\n"
+    "in vec3 vColor;\n"
+    "out vec4 fragColor;\n"
+    "void main() {\n"
+    "    fragColor = vec4(vColor, 1.0);\n"
+    "}\n";
+
+// Instanced mesh shader: the model transform is built from per-instance
+// scale, rotation (quaternion) and translation instead of a CPU matrix.
+// Taper scales the top (y = +0.5) of a mesh relative to its bottom, which
+// turns the unit cylinder into any truncated cone.
+static const char* instancedVertexShaderSource = 
+    "layout(location = 0) in vec3 aPosition;\n"
+    "layout(location = 1) in vec3 aInstancePosition;\n"
+    "layout(location = 2) in vec4 aInstanceSize;\n"
+    "layout(location = 3) in vec4 aInstanceColor;\n"
+    "layout(location = 4) in vec4 aInstanceRotation;\n"
+    "layout(location = 5) in float aInstanceSpace;\n"
+    "out vec3 vColor;\n"
+    "vec3 rotate(vec4 q, vec3 v) {\n"
+    "    return v + 2.0 * cross(q.xyz, cross(q.xyz, v) + q.w * v);\n"
+    "}\n"
+    "void main() {\n"
+    "    vColor = aInstanceColor.rgb;\n"
+    "    float taper = mix(1.0, aInstanceSize.w, aPosition.y + 0.5);\n"
+    "    vec3 local = aPosition * aInstanceSize.xyz * vec3(taper, 1.0, taper);\n"
+    "    vec3 world = rotate(aInstanceRotation, local) + aInstancePosition;\n"
+    "    gl_Position = uViewProj[VIEW_ID] * uDrawSpace[int(aInstanceSpace)] * vec4(world, 1.0);\n"
+    "}\n";
+
+static const char* instancedFragmentShaderSource = 
+    "#version 300 es\n"
+    "precision mediump float;\n"
+    "in vec3 vColor;\n"
     "out vec4 fragColor;\n"
     "void main() {\n"
-    "    fragColor = uColor;\n"
+    "    fragColor = vec4(vColor, 1.0);\n"
     "}\n";
 
-static GLuint CompileShader(GLenum type, const char* source) {
+static GLuint CompileShader(GLenum type, const char* header, const char* source) {
     GLuint shader = glCreateShader(type);
-    glShaderSource(shader, 1, &source, NULL);
+    const char* sources[2] = { header, source };
+    glShaderSource(shader, header ? 2 : 1, header ? sources : &source, NULL);
     glCompileShader(shader);
     
     GLint compiled;
@@ -1576,107 +3132,411 @@ static GLuint CompileShader(GLenum type, const char* source) {
     return shader;
 }
 
-static void InitShaders(void) {
-    if (shaderProgram != 0) return;
-    
-    GLuint vs = CompileShader(GL_VERTEX_SHADER, vertexShaderSource);
-    GLuint fs = CompileShader(GL_FRAGMENT_SHADER, fragmentShaderSource);
+static GLuint LinkProgram(const char* vsSource, const char* fsSource) {
+    const char* vsHeader = vrState.multiview ? vertexHeaderMultiview : vertexHeaderTwoPass;
+    GLuint vs = CompileShader(GL_VERTEX_SHADER, vsHeader, vsSource);
+    GLuint fs = CompileShader(GL_FRAGMENT_SHADER, NULL, fsSource);
     
-    shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vs);
-    glAttachShader(shaderProgram, fs);
-    glLinkProgram(shaderProgram);
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    glLinkProgram(program);
     
     glDeleteShader(vs);
     glDeleteShader(fs);
     
-    uniformMVP = glGetUniformLocation(shaderProgram, "uMVP");
-    uniformColor = glGetUniformLocation(shaderProgram, "uColor");
+    GLint linked;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        char log[512];
+        glGetProgramInfoLog(program, 512, NULL, log);
+        LOGE("Program link error: %s", log);
+    }
+    return program;
 }
 
-// Internal function to draw a cube (used by RenderEye)
-static void DrawCubeInternal(Vector3 position, Vector3 size, Vector3 color) {
-    InitShaders();
-    InitCubeGeometry();
+static void InitShaders(void) {
+    if (shaderProgram != 0) return;
     
-    glUseProgram(shaderProgram);
+    shaderProgram = LinkProgram(vertexShaderSource, fragmentShaderSource);
     
-    // Create model matrix: scale first, then translate
-    Matrix model = MatrixMultiply(MatrixScale(size.x, size.y, size.z),
-                                   MatrixTranslate(position.x, position.y, position.z));
+    instancedProgram = LinkProgram(instancedVertexShaderSource, instancedFragmentShaderSource);
     
-    // Create MVP matrix
-    Matrix mvp = MatrixMultiply(MatrixMultiply(model, vrState.currentViewMatrix), vrState.currentProjectionMatrix);
+    // GLES 3.0 has no layout(binding), so point each program's block at the shared slot
+    glUniformBlockBinding(shaderProgram, glGetUniformBlockIndex(shaderProgram, "ViewBlock"), VIEW_BLOCK_BINDING);
+    glUniformBlockBinding(instancedProgram, glGetUniformBlockIndex(instancedProgram, "ViewBlock"), VIEW_BLOCK_BINDING);
     
-    // Convert to column-major for OpenGL
-    float mvpArray[16] = {
-        mvp.m0, mvp.m1, mvp.m2, mvp.m3,
-        mvp.m4, mvp.m5, mvp.m6, mvp.m7,
-        mvp.m8, mvp.m9, mvp.m10, mvp.m11,
-        mvp.m12, mvp.m13, mvp.m14, mvp.m15
-    };
+    glGenBuffers(MAX_VIEWS, viewUBO);
+}
+
+// Write this frame's view-projection matrices and draw space corrections
+// into the view uniform buffers (std140: mat4 arrays are tightly packed)
+static void UploadViewUniforms(void) {
+    float block[MAX_VIEWS + VR_SPACE_COUNT][16];
+    
+    if (vrState.multiview) {
+        memcpy(block, renderFrame->viewProj, sizeof(renderFrame->viewProj));
+        memcpy(block[MAX_VIEWS], drawSpaceCorrection, sizeof(drawSpaceCorrection));
+        glBindBuffer(GL_UNIFORM_BUFFER, viewUBO[0]);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(block), block, GL_STREAM_DRAW);
+    } else {
+        memcpy(block[1], drawSpaceCorrection, sizeof(drawSpaceCorrection));
+        for (uint32_t i = 0; i < vrState.viewCount; i++) {
+            memcpy(block[0], renderFrame->viewProj[i], sizeof(block[0]));
+            glBindBuffer(GL_UNIFORM_BUFFER, viewUBO[i]);
+            glBufferData(GL_UNIFORM_BUFFER, (1 + VR_SPACE_COUNT) * sizeof(block[0]), block, GL_STREAM_DRAW);
+        }
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+// -----------------------------------------------------------------------------
+// Frustum culling: runs once per frame on the recorded streams, keeping what
+// is inside either eye's frustum, so both eyes replay only visible commands
+// -----------------------------------------------------------------------------
+
+// Planes (xyz normal, w distance; inside when dot >= 0) extracted from a
+// column-major view-projection matrix
+static void ExtractFrustumPlanes(const float* m, Vector4* planes) {
+    for (int i = 0; i < 3; i++) {
+        planes[i * 2] = (Vector4){ m[3] + m[i], m[7] + m[4 + i], m[11] + m[8 + i], m[15] + m[12 + i] };
+        planes[i * 2 + 1] = (Vector4){ m[3] - m[i], m[7] - m[4 + i], m[11] - m[8 + i], m[15] - m[12 + i] };
+    }
+    for (int i = 0; i < 6; i++) {
+        float len = sqrtf(planes[i].x * planes[i].x + planes[i].y * planes[i].y + planes[i].z * planes[i].z);
+        planes[i].x /= len;
+        planes[i].y /= len;
+        planes[i].z /= len;
+        planes[i].w /= len;
+    }
+}
+
+static bool SphereInFrustum(const Vector4* planes, Vector3 center, float radius) {
+    for (int i = 0; i < 6; i++) {
+        if (planes[i].x * center.x + planes[i].y * center.y + planes[i].z * center.z + planes[i].w < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Union of the eye frusta: visible if inside any of them
+static bool IsSphereVisible(const Vector4 (*planes)[6], Vector3 center, float radius) {
+    for (uint32_t i = 0; i < vrState.viewCount; i++) {
+        if (SphereInFrustum(planes[i], center, radius)) return true;
+    }
+    return false;
+}
+
+// Bounding radius of a unit mesh scaled by size (taper can widen the top)
+static float InstanceBoundingRadius(Vector4 size) {
+    float radial = fmaxf(size.w, 1.0f);
+    return 0.5f * sqrtf(size.x * size.x * radial * radial + size.y * size.y + size.z * size.z * radial * radial);
+}
+
+// Compact the streams in place, keeping command order. Attached draws are
+// kept: they sit next to the user and move after culling
+static void CullDrawCommands(void) {
+    Vector4 planes[MAX_VIEWS][6];
+    for (uint32_t i = 0; i < vrState.viewCount; i++) {
+        ExtractFrustumPlanes(renderFrame->viewProj[i], planes[i]);
+    }
     
-    glUniformMatrix4fv(uniformMVP, 1, GL_FALSE, mvpArray);
-    glUniform4f(uniformColor, color.x, color.y, color.z, 1.0f);
+    int culled = 0;
+    
+    for (int m = 0; m < MESH_COUNT; m++) {
+        InstanceStream* stream = &renderArena->meshes[m];
+        int kept = 0;
+        for (int i = 0; i < stream->count; i++) {
+            if (stream->spaces[i] == VR_SPACE_WORLD &&
+                !IsSphereVisible(planes, stream->positions[i], InstanceBoundingRadius(stream->sizes[i]))) continue;
+            
+            if (kept != i) {
+                stream->positions[kept] = stream->positions[i];
+                stream->sizes[kept] = stream->sizes[i];
+                stream->rotations[kept] = stream->rotations[i];
+                stream->colors[kept] = stream->colors[i];
+                stream->spaces[kept] = stream->spaces[i];
+            }
+            kept++;
+        }
+        culled += stream->count - kept;
+        stream->count = kept;
+    }
     
-    glBindVertexArray(cubeVAO);
-    glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_SHORT, 0);
-    glBindVertexArray(0);
+    LineStream* lines = &renderArena->lines;
+    int kept = 0;
+    for (int i = 0; i < lines->count; i++) {
+        Vector3 start = lines->positions[i * 2];
+        Vector3 end = lines->positions[i * 2 + 1];
+        Vector3 center = Vector3Scale(Vector3Add(start, end), 0.5f);
+        if (lines->spaces[i * 2] == VR_SPACE_WORLD &&
+            !IsSphereVisible(planes, center, 0.5f * Vector3Distance(start, end))) continue;
+        
+        if (kept != i) {
+            lines->positions[kept * 2] = start;
+            lines->positions[kept * 2 + 1] = end;
+            lines->colors[kept * 2] = lines->colors[i * 2];
+            lines->colors[kept * 2 + 1] = lines->colors[i * 2 + 1];
+            lines->spaces[kept * 2] = lines->spaces[i * 2];
+            lines->spaces[kept * 2 + 1] = lines->spaces[i * 2 + 1];
+        }
+        kept++;
+    }
+    culled += lines->count - kept;
+    lines->count = kept;
+    
+    renderArena->culled = culled;
 }
 
-// Internal function to draw a line (used by RenderEye)
-static void DrawLineInternal(Vector3 startPos, Vector3 endPos, Vector3 color) {
-    InitShaders();
-    glUseProgram(shaderProgram);
+// Orphan the previous storage so the driver doesn't stall on last frame's draws
+static void UploadStream(GLuint vbo, GLsizeiptr capacityBytes, GLsizeiptr usedBytes, const void* data) {
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, capacityBytes, NULL, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, usedBytes, data);
+}
+
+// Pick a LOD from the larger projected radius (in pixels) over both eyes.
+// One choice serves both eyes, so multiview and two-pass draw the same batches.
+static int SelectMeshLOD(Vector3 position, Vector4 size) {
+    float radius = 0.5f * fmaxf(size.x, fmaxf(size.y, size.z));
+    float projected = 0.0f;
+    float focalScale = vrState.resolutionScale;   // Render path: this frame's scale
     
-    float vertices[] = {
-        startPos.x, startPos.y, startPos.z,
-        endPos.x, endPos.y, endPos.z
-    };
+    for (uint32_t i = 0; i < vrState.viewCount; i++) {
+        float distance = Vector3Distance(position, renderFrame->eyeWorldPosition[i]);
+        if (distance <= radius) return 0;
+        projected = fmaxf(projected, radius / distance * renderFrame->eyeFocalPixels[i] * focalScale);
+    }
     
-    GLuint lineVAO, lineVBO;
-    glGenVertexArrays(1, &lineVAO);
-    glGenBuffers(1, &lineVBO);
+    if (projected >= MESH_LOD0_MIN_PIXELS) return 0;
+    if (projected >= MESH_LOD1_MIN_PIXELS) return 1;
+    return 2;
+}
+
+// Primitive rank: triangles first so large opaque meshes fill depth before lines
+static uint64_t BatchSortKey(GLenum primitive, GLuint program, GLuint vao, int geometry) {
+    uint64_t primitiveRank = (primitive == GL_TRIANGLES) ? 0 : 1;
+    return (primitiveRank << 56) | ((uint64_t)(program & 0xFFFFFF) << 32) |
+        ((uint64_t)(vao & 0xFFFF) << 16) | (uint64_t)(geometry & 0xFFFF);
+}
+
+static void AddMeshBatch(MeshType mesh, int lod, int first, int count) {
+    renderBatches[renderBatchCount++] = (RenderBatch){
+        BatchSortKey(GL_TRIANGLES, instancedProgram, meshVAO, mesh * MESH_LOD_COUNT + lod),
+        GL_TRIANGLES, instancedProgram, meshVAO, mesh, lod, first, count
+    };
+}
+
+static int CompareRenderBatches(const void* a, const void* b) {
+    uint64_t ka = ((const RenderBatch*)a)->sortKey;
+    uint64_t kb = ((const RenderBatch*)b)->sortKey;
+    return (ka > kb) - (ka < kb);
+}
+
+// Sort the LOD-aware streams into contiguous (mesh, LOD) runs after the cubes
+// and build this frame's sorted batch list
+static void BuildRenderBatches(void) {
+    InstanceStream* cubes = &renderArena->meshes[MESH_CUBE];
+    renderBatchCount = 0;
+    lodStaging.count = 0;
+    
+    if (cubes->count > 0) {
+        AddMeshBatch(MESH_CUBE, 0, 0, cubes->count);
+    }
+    if (renderArena->lines.count > 0) {
+        renderBatches[renderBatchCount++] = (RenderBatch){
+            BatchSortKey(GL_LINES, shaderProgram, lineVAO, 0),
+            GL_LINES, shaderProgram, lineVAO, MESH_CUBE, 0, 0, renderArena->lines.count * 2
+        };
+    }
     
-    glBindVertexArray(lineVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, lineVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
+    int roundCount = 0;
+    for (int m = MESH_CUBE + 1; m < MESH_COUNT; m++) {
+        roundCount += renderArena->meshes[m].count;
+    }
     
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
+    if (roundCount > lodStaging.capacity) {
+        if (!GrowInstanceStream(&lodStaging, roundCount)) {
+            LOGE("Failed to grow LOD staging - skipping %d round meshes", roundCount);
+            roundCount = 0;
+        } else {
+            unsigned char* lods = realloc(lodScratch, lodStaging.capacity);
+            if (lods == NULL) roundCount = 0;
+            else lodScratch = lods;
+        }
+    }
     
-    // Create MVP matrix (identity model)
-    Matrix mvp = MatrixMultiply(vrState.currentViewMatrix, vrState.currentProjectionMatrix);
+    for (int m = MESH_CUBE + 1; m < MESH_COUNT && roundCount > 0; m++) {
+        InstanceStream* stream = &renderArena->meshes[m];
+        if (stream->count == 0) continue;
+        
+        // Counting sort by LOD: classify, then scatter each LOD range in order
+        int lodCount[MESH_LOD_COUNT] = {0};
+        for (int i = 0; i < stream->count; i++) {
+            lodScratch[i] = (unsigned char)SelectMeshLOD(stream->positions[i], stream->sizes[i]);
+            lodCount[lodScratch[i]]++;
+        }
+        
+        for (int lod = 0; lod < MESH_LOD_COUNT; lod++) {
+            if (lodCount[lod] == 0) continue;
+            
+            AddMeshBatch((MeshType)m, lod, cubes->count + lodStaging.count, lodCount[lod]);
+            for (int i = 0; i < stream->count; i++) {
+                if (lodScratch[i] != lod) continue;
+                
+                int dst = lodStaging.count++;
+                lodStaging.positions[dst] = stream->positions[i];
+                lodStaging.sizes[dst] = stream->sizes[i];
+                lodStaging.rotations[dst] = stream->rotations[i];
+                lodStaging.colors[dst] = stream->colors[i];
+                lodStaging.spaces[dst] = stream->spaces[i];
+            }
+        }
+    }
     
-    float mvpArray[16] = {
-        mvp.m0, mvp.m1, mvp.m2, mvp.m3,
-        mvp.m4, mvp.m5, mvp.m6, mvp.m7,
-        mvp.m8, mvp.m9, mvp.m10, mvp.m11,
-        mvp.m12, mvp.m13, mvp.m14, mvp.m15
-    };
+    qsort(renderBatches, renderBatchCount, sizeof(RenderBatch), CompareRenderBatches);
+}
+
+// Upload one instance attribute: cubes straight from their stream, then the LOD-sorted meshes
+static void UploadInstanceAttribute(GLuint vbo, size_t elementSize, const void* cubeData, const void* stagingData) {
+    InstanceStream* cubes = &renderArena->meshes[MESH_CUBE];
+    UploadStream(vbo, (cubes->capacity + lodStaging.capacity) * elementSize, cubes->count * elementSize, cubeData);
+    if (lodStaging.count > 0) {
+        glBufferSubData(GL_ARRAY_BUFFER, cubes->count * elementSize, lodStaging.count * elementSize, stagingData);
+    }
+}
+
+// Upload the mesh instance and line streams (once per frame)
+static void UploadDrawStreams(void) {
+    BuildRenderBatches();
+    if (renderArena->meshes[MESH_CUBE].count + lodStaging.count > 0) {
+        InstanceStream* cubes = &renderArena->meshes[MESH_CUBE];
+        UploadInstanceAttribute(instancePositionVBO, sizeof(Vector3), cubes->positions, lodStaging.positions);
+        UploadInstanceAttribute(instanceSizeVBO, sizeof(Vector4), cubes->sizes, lodStaging.sizes);
+        UploadInstanceAttribute(instanceRotationVBO, sizeof(Quaternion), cubes->rotations, lodStaging.rotations);
+        UploadInstanceAttribute(instanceColorVBO, sizeof(Color), cubes->colors, lodStaging.colors);
+        UploadInstanceAttribute(instanceSpaceVBO, sizeof(unsigned char), cubes->spaces, lodStaging.spaces);
+    }
     
-    glUniformMatrix4fv(uniformMVP, 1, GL_FALSE, mvpArray);
-    glUniform4f(uniformColor, color.x, color.y, color.z, 1.0f);
+    LineStream* lines = &renderArena->lines;
+    if (lines->count > 0) {
+        UploadStream(linePositionVBO, lines->capacity * 2 * sizeof(Vector3), lines->count * 2 * sizeof(Vector3), lines->positions);
+        UploadStream(lineColorVBO, lines->capacity * 2 * sizeof(Color), lines->count * 2 * sizeof(Color), lines->colors);
+        UploadStream(lineSpaceVBO, lines->capacity * 2, lines->count * 2, lines->spaces);
+    }
     
-    glDrawArrays(GL_LINES, 0, 2);
+    GlyphStream* glyphs = &renderArena->glyphs;
+    if (glyphs->count > 0) {
+        UploadStream(textInstanceVBO, glyphs->capacity * sizeof(GlyphInstance),
+                     glyphs->count * sizeof(GlyphInstance), glyphs->instances);
+    }
     
-    glBindVertexArray(0);
-    glDeleteBuffers(1, &lineVBO);
-    glDeleteVertexArrays(1, &lineVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    UploadHandBlock();
+}
+
+// Point the per-instance attributes at the first instance of a batch
+// (GLES 3.0 has no base instance, so the offset goes into the pointers)
+static void BindInstanceAttributes(int firstInstance) {
+    glBindBuffer(GL_ARRAY_BUFFER, instancePositionVBO);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vector3), (void*)(firstInstance * sizeof(Vector3)));
+    glBindBuffer(GL_ARRAY_BUFFER, instanceSizeVBO);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(Vector4), (void*)(firstInstance * sizeof(Vector4)));
+    glBindBuffer(GL_ARRAY_BUFFER, instanceColorVBO);
+    glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Color), (void*)(firstInstance * sizeof(Color)));
+    glBindBuffer(GL_ARRAY_BUFFER, instanceRotationVBO);
+    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(Quaternion), (void*)(firstInstance * sizeof(Quaternion)));
+    glBindBuffer(GL_ARRAY_BUFFER, instanceSpaceVBO);
+    glVertexAttribPointer(5, 1, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(unsigned char), (void*)(firstInstance * sizeof(unsigned char)));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+static void UseProgramCached(GLuint program) {
+    if (glCache.program == program) return;
+    glUseProgram(program);
+    glCache.program = program;
+    glCache.stateChanges++;
+}
+
+static void BindVertexArrayCached(GLuint vao) {
+    if (glCache.vao == vao) return;
+    glBindVertexArray(vao);
+    glCache.vao = vao;
+    glCache.stateChanges++;
+}
+
+static void BindInstanceAttributesCached(int firstInstance) {
+    if (glCache.instanceOffset == firstInstance) return;
+    BindInstanceAttributes(firstInstance);
+    glCache.instanceOffset = firstInstance;
+    glCache.stateChanges++;
+}
+
+// Draw the sorted batch list (used by RenderEye). View-projection comes from
+// the bound ViewBlock; mesh model transforms are applied per instance.
+static void DrawRenderBatches(void) {
+    for (int b = 0; b < renderBatchCount; b++) {
+        RenderBatch* batch = &renderBatches[b];
+        
+        UseProgramCached(batch->program);
+        BindVertexArrayCached(batch->vao);
+        
+        if (batch->primitive == GL_TRIANGLES) {
+            MeshLOD* lod = &meshLODs[batch->mesh][batch->lod];
+            BindInstanceAttributesCached(batch->first);
+            glDrawElementsInstanced(GL_TRIANGLES, lod->indexCount, GL_UNSIGNED_SHORT,
+                (void*)(lod->firstIndex * sizeof(unsigned short)), batch->count);
+        } else {
+            glDrawArrays(batch->primitive, batch->first, batch->count);
+        }
+        glCache.drawCalls++;
+    }
+}
+
+// Depth is only needed while an eye renders. Invalidating it lets a tiler
+// drop it with the tile instead of writing it back to memory
+static void InvalidateDepthAttachment(void) {
+    const GLenum attachments[] = { vrState.depthAttachment };
+    glInvalidateFramebuffer(GL_FRAMEBUFFER, 1, attachments);
 }
 
 static void RenderEye(int eye, uint32_t imageIndex) {
-    // Bind framebuffer with the acquired swapchain image
-    glBindFramebuffer(GL_FRAMEBUFFER, vrState.framebuffer[eye]);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 
-        vrState.swapchainImages[eye][imageIndex].image, 0);
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, 
-        GL_RENDERBUFFER, vrState.depthBuffer[eye]);
+    GLint width = vrState.renderWidth[eye];
+    GLint height = vrState.renderHeight[eye];
+    
+    // Framebuffer of the acquired swapchain image, or the MSAA fallback target
+    GLuint imageFramebuffer = vrState.framebuffers[eye][imageIndex];
+    glBindFramebuffer(GL_FRAMEBUFFER, vrState.msaaResolveBlit ? vrState.msaaFramebuffer[eye] : imageFramebuffer);
     
     // Set viewport
-    glViewport(0, 0, vrState.viewConfig[eye].recommendedImageRectWidth,
-        vrState.viewConfig[eye].recommendedImageRectHeight);
+    glViewport(0, 0, width, height);
+    
+    ReplayDrawCommands();
+    InvalidateDepthAttachment();
     
+    if (vrState.msaaResolveBlit) {
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, imageFramebuffer);
+        glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        
+        const GLenum samples[] = { GL_COLOR_ATTACHMENT0 };
+        glInvalidateFramebuffer(GL_READ_FRAMEBUFFER, 1, samples);
+    }
+}
+
+// Render both eyes at once into the layers of the array swapchain image
+static void RenderMultiview(uint32_t imageIndex) {
+    glBindFramebuffer(GL_FRAMEBUFFER, vrState.framebuffers[0][imageIndex]);
+    
+    glViewport(0, 0, vrState.renderWidth[0], vrState.renderHeight[0]);
+    
+    vrState.currentEye = 0;
+    ReplayDrawCommands();
+    InvalidateDepthAttachment();
+}
+
+// Clear the bound framebuffer and replay this frame's draw commands into it
+static void ReplayDrawCommands(void) {
     // Clear with a dark blue color so we can see something
     glClearColor(0.1f, 0.1f, 0.2f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -1685,27 +3545,19 @@ static void RenderEye(int eye, uint32_t imageIndex) {
     glEnable(GL_DEPTH_TEST);
     glDepthFunc(GL_LESS);
     
-    // Initialize shaders if needed
-    InitShaders();
-    InitCubeGeometry();
+    // This eye's view-projection (both eyes in multiview)
+    glBindBufferBase(GL_UNIFORM_BUFFER, VIEW_BLOCK_BINDING, viewUBO[vrState.currentEye]);
     
     // Replay all stored draw commands
     static int frameCount = 0;
-    if (eye == 0 && ++frameCount % 100 == 0) {
-        LOGD("Rendering frame %d with %d draw commands", frameCount, drawCommandCount);
+    if (vrState.currentEye == 0 && ++frameCount % 100 == 0) {
+        LOGD("Rendering frame %d with %d draw commands", frameCount, GetDrawCommandCount(renderArena));
     }
     
-    for (int i = 0; i < drawCommandCount; i++) {
-        DrawCommand* cmd = &drawCommands[i];
-        switch (cmd->type) {
-            case CMD_DRAW_CUBE:
-                DrawCubeInternal(cmd->position, cmd->size, cmd->color);
-                break;
-            case CMD_DRAW_LINE:
-                DrawLineInternal(cmd->position, cmd->size, cmd->color);
-                break;
-        }
-    }
+    // Meshes in one instanced draw per (mesh, LOD), all lines in one batched draw
+    DrawRenderBatches();
+    DrawHandBatches();
+    DrawTextBatch();
 }
 
 // Cube vertices
@@ -1751,56 +3603,571 @@ static const unsigned short cubeIndices[] = {
     20, 21, 22,   20, 22, 23,   // left
 };
 
-static void InitCubeGeometry(void) {
-    if (cubeVAO != 0) return;
+// -----------------------------------------------------------------------------
+// Geometry cache: every mesh and LOD lives in one static VBO/EBO, built once
+// at init. Meshes are unit sized and centered (radius 0.5, y in [-0.5, 0.5]).
+// -----------------------------------------------------------------------------
+
+#define MESH_MAX_VERTICES 2048
+#define MESH_MAX_INDICES 8192
+
+typedef struct {
+    Vector3* vertices;
+    unsigned short* indices;
+    int vertexCount;
+    int indexCount;
+} MeshBuilder;
+
+static int MeshAddVertex(MeshBuilder* b, float x, float y, float z) {
+    b->vertices[b->vertexCount] = (Vector3){ x, y, z };
+    return b->vertexCount++;
+}
+
+static void MeshAddTriangle(MeshBuilder* b, int i0, int i1, int i2) {
+    b->indices[b->indexCount++] = (unsigned short)i0;
+    b->indices[b->indexCount++] = (unsigned short)i1;
+    b->indices[b->indexCount++] = (unsigned short)i2;
+}
+
+static void BuildCube(MeshBuilder* b) {
+    int base = b->vertexCount;
+    for (int i = 0; i < 24; i++) {
+        MeshAddVertex(b, cubeVertices[i * 3], cubeVertices[i * 3 + 1], cubeVertices[i * 3 + 2]);
+    }
+    for (int i = 0; i < 36; i += 3) {
+        MeshAddTriangle(b, base + cubeIndices[i], base + cubeIndices[i + 1], base + cubeIndices[i + 2]);
+    }
+}
+
+// Geodesic sphere: each icosahedron face split into a grid of n*n triangles
+static void BuildIcosphere(MeshBuilder* b, int n) {
+    const float t = 1.618034f;
+    static const int faces[20][3] = {
+        {0, 11, 5}, {0, 5, 1}, {0, 1, 7}, {0, 7, 10}, {0, 10, 11},
+        {1, 5, 9}, {5, 11, 4}, {11, 10, 2}, {10, 7, 6}, {7, 1, 8},
+        {3, 9, 4}, {3, 4, 2}, {3, 2, 6}, {3, 6, 8}, {3, 8, 9},
+        {4, 9, 5}, {2, 4, 11}, {6, 2, 10}, {8, 6, 7}, {9, 8, 1}
+    };
+    Vector3 ico[12] = {
+        {-1, t, 0}, {1, t, 0}, {-1, -t, 0}, {1, -t, 0},
+        {0, -1, t}, {0, 1, t}, {0, -1, -t}, {0, 1, -t},
+        {t, 0, -1}, {t, 0, 1}, {-t, 0, -1}, {-t, 0, 1}
+    };
+    
+    for (int f = 0; f < 20; f++) {
+        Vector3 a = ico[faces[f][0]];
+        Vector3 ab = Vector3Subtract(ico[faces[f][1]], a);
+        Vector3 ac = Vector3Subtract(ico[faces[f][2]], a);
+        int base = b->vertexCount;
+        
+        // Row i holds n + 1 - i vertices
+        for (int i = 0; i <= n; i++) {
+            for (int j = 0; j <= n - i; j++) {
+                Vector3 p = Vector3Add(a, Vector3Add(Vector3Scale(ab, (float)j / n), Vector3Scale(ac, (float)i / n)));
+                p = Vector3Scale(Vector3Normalize(p), 0.5f);
+                MeshAddVertex(b, p.x, p.y, p.z);
+            }
+        }
+        
+        int row = base;
+        for (int i = 0; i < n; i++) {
+            int next = row + (n + 1 - i);
+            for (int j = 0; j < n - i; j++) {
+                MeshAddTriangle(b, row + j, row + j + 1, next + j);
+                if (j < n - i - 1) {
+                    MeshAddTriangle(b, row + j + 1, next + j + 1, next + j);
+                }
+            }
+            row = next;
+        }
+    }
+}
+
+static void BuildCylinder(MeshBuilder* b, int segments) {
+    int bottom = b->vertexCount;
+    for (int k = 0; k < segments; k++) {
+        float a = 2.0f * PI * k / segments;
+        MeshAddVertex(b, 0.5f * cosf(a), -0.5f, 0.5f * sinf(a));
+    }
+    int top = b->vertexCount;
+    for (int k = 0; k < segments; k++) {
+        float a = 2.0f * PI * k / segments;
+        MeshAddVertex(b, 0.5f * cosf(a), 0.5f, 0.5f * sinf(a));
+    }
+    int bottomCenter = MeshAddVertex(b, 0.0f, -0.5f, 0.0f);
+    int topCenter = MeshAddVertex(b, 0.0f, 0.5f, 0.0f);
+    
+    for (int k = 0; k < segments; k++) {
+        int k1 = (k + 1) % segments;
+        MeshAddTriangle(b, bottom + k, bottom + k1, top + k);
+        MeshAddTriangle(b, top + k, bottom + k1, top + k1);
+        MeshAddTriangle(b, bottomCenter, bottom + k1, bottom + k);
+        MeshAddTriangle(b, topCenter, top + k, top + k1);
+    }
+}
+
+static void BuildCone(MeshBuilder* b, int segments) {
+    int ring = b->vertexCount;
+    for (int k = 0; k < segments; k++) {
+        float a = 2.0f * PI * k / segments;
+        MeshAddVertex(b, 0.5f * cosf(a), -0.5f, 0.5f * sinf(a));
+    }
+    int apex = MeshAddVertex(b, 0.0f, 0.5f, 0.0f);
+    int baseCenter = MeshAddVertex(b, 0.0f, -0.5f, 0.0f);
+    
+    for (int k = 0; k < segments; k++) {
+        int k1 = (k + 1) % segments;
+        MeshAddTriangle(b, ring + k, ring + k1, apex);
+        MeshAddTriangle(b, baseCenter, ring + k1, ring + k);
+    }
+}
+
+static void InitMeshGeometry(void) {
+    if (meshVAO != 0) return;
+    
+    // LOD 0 is the most detailed
+    static const int sphereDivisions[MESH_LOD_COUNT] = { 4, 2, 1 };       // 320, 80, 20 triangles
+    static const int roundSegments[MESH_LOD_COUNT] = { 32, 16, 8 };
+    
+    MeshBuilder b = {
+        .vertices = malloc(MESH_MAX_VERTICES * sizeof(Vector3)),
+        .indices = malloc(MESH_MAX_INDICES * sizeof(unsigned short))
+    };
+    
+    for (int m = 0; m < MESH_COUNT; m++) {
+        for (int lod = 0; lod < MESH_LOD_COUNT; lod++) {
+            int firstIndex = b.indexCount;
+            switch (m) {
+                case MESH_CUBE:
+                    // Single LOD; every level shares it
+                    if (lod == 0) BuildCube(&b);
+                    else firstIndex = meshLODs[m][0].firstIndex;
+                    break;
+                case MESH_SPHERE:   BuildIcosphere(&b, sphereDivisions[lod]); break;
+                case MESH_CYLINDER: BuildCylinder(&b, roundSegments[lod]); break;
+                case MESH_CONE:     BuildCone(&b, roundSegments[lod]); break;
+            }
+            meshLODs[m][lod].firstIndex = firstIndex;
+            meshLODs[m][lod].indexCount = (m == MESH_CUBE) ? 36 : b.indexCount - firstIndex;
+        }
+    }
     
-    glGenVertexArrays(1, &cubeVAO);
-    glGenBuffers(1, &cubeVBO);
-    glGenBuffers(1, &cubeEBO);
+    LOGI("Mesh cache built: %d vertices, %d indices", b.vertexCount, b.indexCount);
     
-    glBindVertexArray(cubeVAO);
+    glGenVertexArrays(1, &meshVAO);
+    glGenBuffers(1, &meshVBO);
+    glGenBuffers(1, &meshEBO);
+    glGenBuffers(1, &instancePositionVBO);
+    glGenBuffers(1, &instanceSizeVBO);
+    glGenBuffers(1, &instanceRotationVBO);
+    glGenBuffers(1, &instanceColorVBO);
+    glGenBuffers(1, &instanceSpaceVBO);
     
-    glBindBuffer(GL_ARRAY_BUFFER, cubeVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(cubeVertices), cubeVertices, GL_STATIC_DRAW);
+    glBindVertexArray(meshVAO);
     
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, cubeEBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(cubeIndices), cubeIndices, GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, meshVBO);
+    glBufferData(GL_ARRAY_BUFFER, b.vertexCount * sizeof(Vector3), b.vertices, GL_STATIC_DRAW);
+    
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshEBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, b.indexCount * sizeof(unsigned short), b.indices, GL_STATIC_DRAW);
+    
+    free(b.vertices);
+    free(b.indices);
     
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
     
+    // Per-instance attributes (advance once per instance, not per vertex).
+    // Storage is (re)specified in UploadDrawStreams, pointers per batch
+    for (GLuint attrib = 1; attrib <= 5; attrib++) {
+        glEnableVertexAttribArray(attrib);
+        glVertexAttribDivisor(attrib, 1);
+    }
+    BindInstanceAttributes(0);
+    
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+static void InitLineGeometry(void) {
+    if (lineVAO != 0) return;
+    
+    glGenVertexArrays(1, &lineVAO);
+    glGenBuffers(1, &linePositionVBO);
+    glGenBuffers(1, &lineColorVBO);
+    glGenBuffers(1, &lineSpaceVBO);
+    
+    glBindVertexArray(lineVAO);
+    
+    // Storage is (re)specified each frame in UploadDrawStreams
+    glBindBuffer(GL_ARRAY_BUFFER, linePositionVBO);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vector3), (void*)0);
+    glEnableVertexAttribArray(0);
+    
+    glBindBuffer(GL_ARRAY_BUFFER, lineColorVBO);
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Color), (void*)0);
+    glEnableVertexAttribArray(1);
+    
+    glBindBuffer(GL_ARRAY_BUFFER, lineSpaceVBO);
+    glVertexAttribPointer(2, 1, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(unsigned char), (void*)0);
+    glEnableVertexAttribArray(2);
+    
     glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// -----------------------------------------------------------------------------
+// Hand renderer: joint spheres and bone capsules for both hands in two
+// instanced draws. Every joint and bone slot is always drawn; invalid ones
+// have zero radius and collapse, so the cost does not depend on tracking.
+// Bones are cylinders between joints, capped by the joint spheres.
+// -----------------------------------------------------------------------------
+
+#define HAND_BONE_COUNT 27
+
+// Joint pairs of each bone (OpenXR XR_HAND_JOINT_EXT order)
+static const unsigned char handBones[HAND_BONE_COUNT][2] = {
+    // Thumb
+    {HAND_JOINT_WRIST, HAND_JOINT_THUMB_METACARPAL},
+    {HAND_JOINT_THUMB_METACARPAL, HAND_JOINT_THUMB_PROXIMAL},
+    {HAND_JOINT_THUMB_PROXIMAL, HAND_JOINT_THUMB_DISTAL},
+    {HAND_JOINT_THUMB_DISTAL, HAND_JOINT_THUMB_TIP},
+    // Index
+    {HAND_JOINT_WRIST, HAND_JOINT_INDEX_METACARPAL},
+    {HAND_JOINT_INDEX_METACARPAL, HAND_JOINT_INDEX_PROXIMAL},
+    {HAND_JOINT_INDEX_PROXIMAL, HAND_JOINT_INDEX_INTERMEDIATE},
+    {HAND_JOINT_INDEX_INTERMEDIATE, HAND_JOINT_INDEX_DISTAL},
+    {HAND_JOINT_INDEX_DISTAL, HAND_JOINT_INDEX_TIP},
+    // Middle
+    {HAND_JOINT_WRIST, HAND_JOINT_MIDDLE_METACARPAL},
+    {HAND_JOINT_MIDDLE_METACARPAL, HAND_JOINT_MIDDLE_PROXIMAL},
+    {HAND_JOINT_MIDDLE_PROXIMAL, HAND_JOINT_MIDDLE_INTERMEDIATE},
+    {HAND_JOINT_MIDDLE_INTERMEDIATE, HAND_JOINT_MIDDLE_DISTAL},
+    {HAND_JOINT_MIDDLE_DISTAL, HAND_JOINT_MIDDLE_TIP},
+    // Ring
+    {HAND_JOINT_WRIST, HAND_JOINT_RING_METACARPAL},
+    {HAND_JOINT_RING_METACARPAL, HAND_JOINT_RING_PROXIMAL},
+    {HAND_JOINT_RING_PROXIMAL, HAND_JOINT_RING_INTERMEDIATE},
+    {HAND_JOINT_RING_INTERMEDIATE, HAND_JOINT_RING_DISTAL},
+    {HAND_JOINT_RING_DISTAL, HAND_JOINT_RING_TIP},
+    // Little
+    {HAND_JOINT_WRIST, HAND_JOINT_LITTLE_METACARPAL},
+    {HAND_JOINT_LITTLE_METACARPAL, HAND_JOINT_LITTLE_PROXIMAL},
+    {HAND_JOINT_LITTLE_PROXIMAL, HAND_JOINT_LITTLE_INTERMEDIATE},
+    {HAND_JOINT_LITTLE_INTERMEDIATE, HAND_JOINT_LITTLE_DISTAL},
+    {HAND_JOINT_LITTLE_DISTAL, HAND_JOINT_LITTLE_TIP},
+    // Palm connections
+    {HAND_JOINT_INDEX_METACARPAL, HAND_JOINT_MIDDLE_METACARPAL},
+    {HAND_JOINT_MIDDLE_METACARPAL, HAND_JOINT_RING_METACARPAL},
+    {HAND_JOINT_RING_METACARPAL, HAND_JOINT_LITTLE_METACARPAL},
+};
+
+// uHandState per hand: x = draw space, y = joints drawn, z = bones drawn.
+// Spheres take their joint from gl_InstanceID, bones from aBone (joint
+// indices across both hands, one entry per bone instance)
+static const char* handVertexShaderSource = 
+    "layout(location = 0) in vec3 aPosition;\n"
+    "layout(location = 1) in uvec2 aBone;\n"
+    "layout(std140) uniform HandBlock { vec4 uJoints[52]; vec4 uJointColor[2]; vec4 uBoneColor[2]; vec4 uHandState[2]; };\n"
+    "uniform bool uBones;\n"
+    "out vec3 vColor;\n"
+    "void main() {\n"
+    "    int hand;\n"
+    "    vec3 world;\n"
+    "    if (uBones) {\n"
+    "        vec4 a = uJoints[aBone.x];\n"
+    "        vec4 b = uJoints[aBone.y];\n"
+    "        hand = int(aBone.x) / 26;\n"
+    "        vec3 axis = b.xyz - a.xyz;\n"
+    "        float len = length(axis);\n"
+    "        float width = (len > 0.0) ? min(a.w, b.w) * uHandState[hand].z : 0.0;\n"
+    "        vec3 y = (len > 0.0) ? axis / len : vec3(0.0, 1.0, 0.0);\n"
+    "        vec3 x = normalize(cross(abs(y.y) < 0.99 ? vec3(0.0, 1.0, 0.0) : vec3(1.0, 0.0, 0.0), y));\n"
+    "        vec3 local = aPosition * vec3(width, width > 0.0 ? len : 0.0, width);\n"
+    "        world = 0.5 * (a.xyz + b.xyz) + x * local.x + y * local.y + cross(x, y) * local.z;\n"
+    "        vColor = uBoneColor[hand].rgb;\n"
+    "    } else {\n"
+    "        vec4 joint = uJoints[gl_InstanceID];\n"
+    "        hand = gl_InstanceID / 26;\n"
+    "        world = joint.xyz + aPosition * (2.0 * joint.w * uHandState[hand].y);\n"
+    "        vColor = uJointColor[hand].rgb;\n"
+    "    }\n"
+    "    gl_Position = uViewProj[VIEW_ID] * uDrawSpace[int(uHandState[hand].x)] * vec4(world, 1.0);\n"
+    "}\n";
+
+static void InitHandRenderer(void) {
+    if (handVAO != 0) return;
+    
+    handProgram = LinkProgram(handVertexShaderSource, instancedFragmentShaderSource);
+    glUniformBlockBinding(handProgram, glGetUniformBlockIndex(handProgram, "ViewBlock"), VIEW_BLOCK_BINDING);
+    glUniformBlockBinding(handProgram, glGetUniformBlockIndex(handProgram, "HandBlock"), HAND_BLOCK_BINDING);
+    handBonesLocation = glGetUniformLocation(handProgram, "uBones");
+    
+    // Bone endpoints for both hands, indexing the joints of the hand block
+    unsigned char bones[2 * HAND_BONE_COUNT][2];
+    for (int hand = 0; hand < 2; hand++) {
+        for (int b = 0; b < HAND_BONE_COUNT; b++) {
+            bones[hand * HAND_BONE_COUNT + b][0] = (unsigned char)(hand * HAND_JOINT_COUNT + handBones[b][0]);
+            bones[hand * HAND_BONE_COUNT + b][1] = (unsigned char)(hand * HAND_JOINT_COUNT + handBones[b][1]);
+        }
+    }
+    
+    glGenVertexArrays(1, &handVAO);
+    glGenBuffers(1, &handBoneVBO);
+    glGenBuffers(1, &handUBO);
+    
+    // Unit meshes come from the geometry cache
+    glBindVertexArray(handVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, meshVBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshEBO);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    
+    glBindBuffer(GL_ARRAY_BUFFER, handBoneVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(bones), bones, GL_STATIC_DRAW);
+    glVertexAttribIPointer(1, 2, GL_UNSIGNED_BYTE, 2, (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+    
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+static bool HasHandDraws(const HandDrawList* list) {
+    return list->drawJoints[0] || list->drawJoints[1] || list->drawBones[0] || list->drawBones[1];
+}
+
+static void ColorToVec4(Color color, float* out) {
+    out[0] = color.r / 255.0f;
+    out[1] = color.g / 255.0f;
+    out[2] = color.b / 255.0f;
+    out[3] = color.a / 255.0f;
+}
+
+// Write the hand block (std140: every member is a vec4 array) once per frame
+static void UploadHandBlock(void) {
+    const HandDrawList* list = &renderArena->hands;
+    if (!HasHandDraws(list)) return;
+    
+    float block[2 * HAND_JOINT_COUNT + 6][4];
+    memcpy(block, list->joints, sizeof(list->joints));
+    float (*colors)[4] = &block[2 * HAND_JOINT_COUNT];
+    for (int hand = 0; hand < 2; hand++) {
+        ColorToVec4(list->jointColor[hand], colors[hand]);
+        ColorToVec4(list->boneColor[hand], colors[2 + hand]);
+        colors[4 + hand][0] = list->space[hand];
+        colors[4 + hand][1] = list->drawJoints[hand] ? 1.0f : 0.0f;
+        colors[4 + hand][2] = list->drawBones[hand] ? 1.0f : 0.0f;
+        colors[4 + hand][3] = 0.0f;
+    }
+    
+    glBindBuffer(GL_UNIFORM_BUFFER, handUBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(block), block, GL_STREAM_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+// Joint spheres (medium sphere LOD) and bone capsules (coarse cylinder LOD)
+static void DrawHandBatches(void) {
+    const HandDrawList* list = &renderArena->hands;
+    if (!HasHandDraws(list)) return;
+    
+    UseProgramCached(handProgram);
+    BindVertexArrayCached(handVAO);
+    glBindBufferBase(GL_UNIFORM_BUFFER, HAND_BLOCK_BINDING, handUBO);
+    
+    if (list->drawJoints[0] || list->drawJoints[1]) {
+        const MeshLOD* sphere = &meshLODs[MESH_SPHERE][1];
+        glUniform1i(handBonesLocation, 0);
+        glDrawElementsInstanced(GL_TRIANGLES, sphere->indexCount, GL_UNSIGNED_SHORT,
+            (void*)(sphere->firstIndex * sizeof(unsigned short)), 2 * HAND_JOINT_COUNT);
+        glCache.drawCalls++;
+    }
+    if (list->drawBones[0] || list->drawBones[1]) {
+        const MeshLOD* cylinder = &meshLODs[MESH_CYLINDER][MESH_LOD_COUNT - 1];
+        glUniform1i(handBonesLocation, 1);
+        glDrawElementsInstanced(GL_TRIANGLES, cylinder->indexCount, GL_UNSIGNED_SHORT,
+            (void*)(cylinder->firstIndex * sizeof(unsigned short)), 2 * HAND_BONE_COUNT);
+        glCache.drawCalls++;
+    }
+}
+
+// Hand renderer hooks (realitylib_hands.c)
+void RecordHandJoints(int hand, const VRHandJoints* joints, Color color) {
+    if (!vrState.sessionRunning) return;
+    HandDrawList* list = RecordHandPose(hand, joints);
+    if (list == NULL) return;
+    list->jointColor[hand] = color;
+    list->drawJoints[hand] = true;
+}
+
+void RecordHandBones(int hand, const VRHandJoints* joints, Color color) {
+    if (!vrState.sessionRunning) return;
+    HandDrawList* list = RecordHandPose(hand, joints);
+    if (list == NULL) return;
+    list->boneColor[hand] = color;
+    list->drawBones[hand] = true;
+}
+
+// -----------------------------------------------------------------------------
+// Glyph renderer: one instanced quad per character for all of the frame's
+// text. The atlas holds a signed distance field (0.5 on the glyph edge), so
+// edges stay sharp at any text size and distance.
+// -----------------------------------------------------------------------------
+
+static const char* textVertexShaderSource = 
+    "layout(location = 0) in vec2 aCorner;\n"
+    "layout(location = 1) in vec3 aCenter;\n"
+    "layout(location = 2) in vec3 aHalfRight;\n"
+    "layout(location = 3) in vec3 aHalfUp;\n"
+    "layout(location = 4) in vec4 aAtlasRect;\n"
+    "layout(location = 5) in vec4 aColor;\n"
+    "layout(location = 6) in float aSpace;\n"
+    "out vec3 vColor;\n"
+    "out vec2 vTexCoord;\n"
+    "void main() {\n"
+    "    vColor = aColor.rgb;\n"
+    "    vTexCoord = mix(aAtlasRect.xy, aAtlasRect.zw, vec2(0.5, -0.5) * aCorner + 0.5);\n"
+    "    vec3 world = aCenter + aHalfRight * aCorner.x + aHalfUp * aCorner.y;\n"
+    "    gl_Position = uViewProj[VIEW_ID] * uDrawSpace[int(aSpace)] * vec4(world, 1.0);\n"
+    "}\n";
+
+// Coverage from the distance field, antialiased over about one screen pixel
+static const char* textFragmentShaderSource = 
+    "#version 300 es\n"
+    "precision mediump float;\n"
+    "uniform sampler2D uAtlas;\n"
+    "in vec3 vColor;\n"
+    "in vec2 vTexCoord;\n"
+    "out vec4 fragColor;\n"
+    "void main() {\n"
+    "    float distance = texture(uAtlas, vTexCoord).r;\n"
+    "    float edge = max(fwidth(distance) * 0.7, 0.01);\n"
+    "    float coverage = smoothstep(0.5 - edge, 0.5 + edge, distance);\n"
+    "    if (coverage <= 0.0) discard;\n"
+    "    fragColor = vec4(vColor, coverage);\n"
+    "}\n";
+
+static void InitTextRenderer(void) {
+    if (textVAO != 0) return;
+    
+    textProgram = LinkProgram(textVertexShaderSource, textFragmentShaderSource);
+    glUniformBlockBinding(textProgram, glGetUniformBlockIndex(textProgram, "ViewBlock"), VIEW_BLOCK_BINDING);
+    glUseProgram(textProgram);
+    glUniform1i(glGetUniformLocation(textProgram, "uAtlas"), 0);
+    glUseProgram(0);
+    
+    int width, height;
+    const unsigned char* atlas = GetFontAtlas(&width, &height);
+    glGenTextures(1, &textAtlasTexture);
+    glBindTexture(GL_TEXTURE_2D, textAtlasTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, atlas);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    LOGI("Glyph atlas built: %dx%d SDF", width, height);
+    
+    static const float corners[] = { -1.0f, -1.0f,  1.0f, -1.0f,  -1.0f, 1.0f,  1.0f, 1.0f };
+    
+    glGenVertexArrays(1, &textVAO);
+    glGenBuffers(1, &textQuadVBO);
+    glGenBuffers(1, &textInstanceVBO);
+    
+    glBindVertexArray(textVAO);
+    
+    glBindBuffer(GL_ARRAY_BUFFER, textQuadVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    
+    // Interleaved per-glyph attributes; storage is (re)specified in UploadDrawStreams
+    glBindBuffer(GL_ARRAY_BUFFER, textInstanceVBO);
+    GLsizei stride = sizeof(GlyphInstance);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(GlyphInstance, center));
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(GlyphInstance, halfRight));
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(GlyphInstance, halfUp));
+    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(GlyphInstance, uv));
+    glVertexAttribPointer(5, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void*)offsetof(GlyphInstance, color));
+    glVertexAttribPointer(6, 1, GL_UNSIGNED_BYTE, GL_FALSE, stride, (void*)offsetof(GlyphInstance, space));
+    for (GLuint attrib = 1; attrib <= 6; attrib++) {
+        glEnableVertexAttribArray(attrib);
+        glVertexAttribDivisor(attrib, 1);
+    }
+    
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// All glyphs of the frame in one draw. Text goes last and blends its
+// antialiased edges; only text can end up behind those edge pixels
+static void DrawTextBatch(void) {
+    int count = renderArena->glyphs.count;
+    if (count == 0) return;
+    
+    UseProgramCached(textProgram);
+    BindVertexArrayCached(textVAO);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, textAtlasTexture);
+    
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, count);
+    glDisable(GL_BLEND);
+    glCache.drawCalls++;
+}
+
+// Glyph renderer hook (realitylib_text.c)
+void RecordGlyph(Vector3 center, Vector3 halfRight, Vector3 halfUp, const float uv[4], Color color) {
+    if (!vrState.sessionRunning) return;
+    RecordGlyphQuad(center, halfRight, halfUp, uv, color);
+}
+
+// Pack a normalized (0-1) RGB color into RGBA8
+static Color ColorFromNormalized(Vector3 color) {
+    float r = fminf(fmaxf(color.x, 0.0f), 1.0f);
+    float g = fminf(fmaxf(color.y, 0.0f), 1.0f);
+    float b = fminf(fmaxf(color.z, 0.0f), 1.0f);
+    return (Color){
+        (unsigned char)(r * 255.0f + 0.5f),
+        (unsigned char)(g * 255.0f + 0.5f),
+        (unsigned char)(b * 255.0f + 0.5f),
+        255
+    };
 }
 
 void DrawVRCuboid(Vector3 position, Vector3 size, Vector3 color) {
     if (!vrState.sessionRunning) return;
     
     // Add to command buffer - will be drawn for each eye in EndVRMode
-    DrawCommand cmd = {
-        .type = CMD_DRAW_CUBE,
-        .position = position,
-        .size = size,
-        .color = color
-    };
-    AddDrawCommand(cmd);
+    Vector4 scale = { size.x, size.y, size.z, 1.0f };
+    RecordMesh(MESH_CUBE, position, scale, IDENTITY_ROTATION, ColorFromNormalized(color));
+}
+
+void DrawVRCuboidRotated(Vector3 position, Vector3 size, Quaternion rotation, Color color) {
+    if (!vrState.sessionRunning) return;
+    
+    RecordMesh(MESH_CUBE, position, (Vector4){ size.x, size.y, size.z, 1.0f }, rotation, color);
 }
 
 void DrawVRCube(Vector3 position, float size, Color color) {
-    DrawVRCuboid(position, (Vector3){size, size, size}, 
-        (Vector3){color.r / 255.0f, color.g / 255.0f, color.b / 255.0f});
+    if (!vrState.sessionRunning) return;
+    
+    RecordMesh(MESH_CUBE, position, (Vector4){ size, size, size, 1.0f }, IDENTITY_ROTATION, color);
 }
 
 void DrawVRSphere(Vector3 position, float radius, Color color) {
-    // Simplified: draw as a cube for now (proper sphere needs more geometry)
-    DrawVRCube(position, radius * 2, color);
+    if (!vrState.sessionRunning) return;
+    
+    float d = radius * 2;
+    RecordMesh(MESH_SPHERE, position, (Vector4){ d, d, d, 1.0f }, IDENTITY_ROTATION, color);
 }
 
 void DrawVRGrid(int slices, float spacing) {
     if (!vrState.sessionRunning) return;
     
-    InitShaders();
-    glUseProgram(shaderProgram);
-    
     // Draw grid lines
     float half = (slices * spacing) / 2.0f;
     
@@ -1827,25 +4194,34 @@ void DrawVRLine3D(Vector3 startPos, Vector3 endPos, Color color) {
     if (!vrState.sessionRunning) return;
     
     // Add to command buffer - will be drawn for each eye in EndVRMode
-    // We store startPos in position and endPos in size
-    DrawCommand cmd = {
-        .type = CMD_DRAW_LINE,
-        .position = startPos,
-        .size = endPos,  // Repurposed as end position for lines
-        .color = (Vector3){color.r / 255.0f, color.g / 255.0f, color.b / 255.0f}
-    };
-    AddDrawCommand(cmd);
+    RecordLine(startPos, endPos, color);
 }
 
 void DrawVRCylinder(Vector3 position, float radiusTop, float radiusBottom, float height, Color color) {
-    // Simplified: draw as stretched cube
-    DrawVRCube((Vector3){position.x, position.y + height/2, position.z}, 
-        (radiusTop + radiusBottom), color);
+    if (!vrState.sessionRunning) return;
+    
+    // Meshes are centered, position is the base center
+    Vector3 center = { position.x, position.y + height / 2, position.z };
+    
+    if (radiusTop <= 0.0f && radiusBottom <= 0.0f) return;
+    
+    if (radiusTop <= 0.0f) {
+        float d = radiusBottom * 2;
+        RecordMesh(MESH_CONE, center, (Vector4){ d, height, d, 1.0f }, IDENTITY_ROTATION, color);
+    } else if (radiusBottom <= 0.0f) {
+        // Apex down: the cone flipped half a turn about X
+        float d = radiusTop * 2;
+        RecordMesh(MESH_CONE, center, (Vector4){ d, height, d, 1.0f }, (Quaternion){ 1.0f, 0.0f, 0.0f, 0.0f }, color);
+    } else {
+        float d = radiusBottom * 2;
+        RecordMesh(MESH_CYLINDER, center, (Vector4){ d, height, d, radiusTop / radiusBottom }, IDENTITY_ROTATION, color);
+    }
 }
 
 void DrawVRPlane(Vector3 centerPos, Vector3 size, Color color) {
-    DrawVRCuboid(centerPos, (Vector3){size.x, 0.01f, size.z}, 
-        (Vector3){color.r / 255.0f, color.g / 255.0f, color.b / 255.0f});
+    if (!vrState.sessionRunning) return;
+    
+    RecordMesh(MESH_CUBE, centerPos, (Vector4){ size.x, 0.01f, size.z, 1.0f }, IDENTITY_ROTATION, color);
 }
 
 void DrawVRAxes(Vector3 position, float scale) {
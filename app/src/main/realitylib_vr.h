@@ -90,6 +90,15 @@ typedef enum {
     CONTROLLER_RIGHT = 1
 } ControllerHand;
 
+// Tracked spaces draws can be attached to (see BeginVRDrawSpace)
+typedef enum {
+    VR_SPACE_WORLD = 0,             // Default: drawn exactly where recorded
+    VR_SPACE_LEFT_CONTROLLER,
+    VR_SPACE_RIGHT_CONTROLLER,
+    VR_SPACE_HEAD,
+    VR_SPACE_COUNT
+} VRDrawSpace;
+
 typedef struct VRController {
     Vector3 position;
     Quaternion orientation;
@@ -129,6 +138,60 @@ typedef struct VRHeadset {
     float displayRefreshRate;
 } VRHeadset;
 
+typedef struct VRDrawStats {
+    int commandsSubmitted;  // Draw calls made by the app (including dropped)
+    int commandsDropped;    // Commands lost because the buffer could not grow
+    int commandsCulled;     // Commands outside both eye frusta (not rendered)
+    int commandsVisible;    // Commands rendered
+    int drawCalls;          // GL draw calls issued (all eyes)
+    int stateChanges;       // Program/VAO/attribute binds that were not redundant
+    int peakCommands;       // Most commands recorded in a single frame so far
+    int capacity;           // Current draw command buffer capacity
+} VRDrawStats;
+
+// Per-frame timing in milliseconds (all fields are floats, -1 = no sample)
+#define VR_FRAME_STATS_HISTORY 256
+
+typedef struct VRFrameStats {
+    float waitFrameMs;      // Blocked in xrWaitFrame
+    float appMs;            // From BeginVRMode to EndVRMode (input, inLoop, draw calls)
+    float prepareMs;        // Culling, batching and upload of the recorded commands
+    float eyeMs[2];         // CPU time rendering each eye (multiview: both in [0])
+    float gpuMs;            // GPU time of all eye rendering (GL_EXT_disjoint_timer_query)
+    float endFrameMs;       // Time in xrEndFrame
+    float frameMs;          // CPU time from BeginVRMode to the end of EndVRMode
+    float resolutionScale;  // Render scale of this frame (1 = recommended size)
+} VRFrameStats;
+
+// =============================================================================
+// Configuration Flags
+// =============================================================================
+
+typedef enum {
+    FLAG_VR_NO_MULTIVIEW = 0x00000001,      // Force two-pass stereo even if GL_OVR_multiview2 is available
+    FLAG_VR_THREADED_RENDER = 0x00000002,   // Render and submit on a separate thread, one frame behind the app
+    FLAG_VR_DEPTH_16 = 0x00000004,          // 16-bit depth buffer: less memory and bandwidth, less precision
+    FLAG_VR_DEPTH_NO_STENCIL = 0x00000008,  // 24-bit depth without the unused stencil bits
+    FLAG_VR_MSAA_2X = 0x00000010,           // 2x MSAA, resolved on-tile where supported
+    FLAG_VR_MSAA_4X = 0x00000020,           // 4x MSAA, resolved on-tile where supported
+    FLAG_VR_DYNAMIC_RESOLUTION = 0x00000040 // Scale the render size to keep GPU time within the display period
+} VRConfigFlags;
+
+/**
+ * Set configuration flags (raylib-style)
+ * Call this before InitApp(); flags are read during initialization
+ * @param flags Combination of VRConfigFlags values
+ */
+void SetVRConfigFlags(unsigned int flags);
+
+/**
+ * Set the range FLAG_VR_DYNAMIC_RESOLUTION may scale the render size in
+ * Call this before InitApp(); swapchains are allocated at the maximum
+ * @param minScale Smallest scale of the recommended size (default 0.6)
+ * @param maxScale Largest scale, above 1 to supersample (default 1.0)
+ */
+void SetVRResolutionScaleRange(float minScale, float maxScale);
+
 // =============================================================================
 // Core VR Functions - Application Lifecycle
 // =============================================================================
@@ -151,11 +214,19 @@ void CloseApp(struct android_app* app);
 /**
  * Check if the application should close
  * Use this as your main loop condition
+ * While the session is not running this blocks on Android events for up to
+ * 100 ms instead of returning immediately, so an idle app does not spin
  * @param app Android native app handle
  * @return true if app should close
  */
 bool AppShouldClose(struct android_app* app);
 
+/**
+ * Check if the app has input focus (session state FOCUSED)
+ * @return false while a system menu or another app owns input
+ */
+bool IsVRSessionFocused(void);
+
 // =============================================================================
 // VR Rendering Functions
 // =============================================================================
@@ -172,12 +243,129 @@ void BeginVRMode(void);
  */
 void EndVRMode(void);
 
+/**
+ * Check if the app should update and draw this frame
+ * Call after BeginVRMode(). False while the session is not running, and on
+ * three frames out of four while visible but unfocused; skipped frames
+ * re-render the last drawn frame, and draw calls made in them are ignored
+ * @return true if SyncControllers() and the app's update should run
+ */
+bool ShouldUpdateThisFrame(void);
+
 /**
  * Set the clear/background color for VR rendering
  * @param color Background color
  */
 void SetVRClearColor(Color color);
 
+/**
+ * Check if single-pass stereo (GL_OVR_multiview2) is in use
+ * @return true if both eyes are rendered in one pass
+ */
+bool IsVRMultiviewEnabled(void);
+
+/**
+ * Get the current render scale (FLAG_VR_DYNAMIC_RESOLUTION)
+ * @return Scale of the recommended size; 1 when dynamic resolution is off
+ */
+float GetVRResolutionScale(void);
+
+/**
+ * Get the MSAA sample count in use (FLAG_VR_MSAA_2X / FLAG_VR_MSAA_4X)
+ * Falls back to 1 when the driver cannot render multisampled in this mode
+ * @return Samples per pixel (1 = no MSAA)
+ */
+int GetVRMSAASamples(void);
+
+/**
+ * Check if frames are rendered on the render thread (FLAG_VR_THREADED_RENDER)
+ * The app records frame N+1 while frame N renders; draw and frame stats
+ * then trail the app by one frame
+ * @return true if the render thread is running
+ */
+bool IsVRRenderThreadEnabled(void);
+
+/**
+ * Get the CPU time spent submitting the last frame's rendering
+ * Covers swapchain acquire/wait, draw command replay and release
+ * @return Submit time in milliseconds
+ */
+float GetVRRenderSubmitTime(void);
+
+/**
+ * Get draw command buffer statistics for the last completed frame
+ * Use this to size scenes; the buffer grows on demand and keeps its peak size
+ * @return Submitted, dropped, culled, visible and peak command counts plus capacity
+ */
+VRDrawStats GetVRDrawStats(void);
+
+// =============================================================================
+// Frame Timing
+// =============================================================================
+
+/**
+ * Get the time step for this frame's update in seconds
+ * Measured between the predicted display times of the app's updates, so it
+ * follows the refresh rate (72/90/120 Hz) and grows when frames are
+ * dropped; capped at 0.1 s after a stall
+ */
+float GetFrameTime(void);
+
+/**
+ * Get the runtime's predicted display period in seconds (1 / refresh rate)
+ */
+float GetPredictedDisplayPeriod(void);
+
+/**
+ * Get the number of display refreshes missed since InitApp()
+ * Counted from gaps between consecutive predicted display times
+ */
+int GetMissedFrameCount(void);
+
+/**
+ * Check if the runtime will display this frame
+ * When false, EndVRMode() skips rendering and submits an empty frame, so
+ * the app can skip its drawing too (its update should still run)
+ */
+bool ShouldRenderThisFrame(void);
+
+// =============================================================================
+// Frame Timing Statistics
+// =============================================================================
+
+/**
+ * Get timing of the last completed frame
+ * GPU time resolves a few frames late; use the history accessors for it
+ * @return Frame timing in milliseconds
+ */
+VRFrameStats GetVRFrameStats(void);
+
+/**
+ * Get the number of frames in the timing history (up to VR_FRAME_STATS_HISTORY)
+ */
+int GetVRFrameStatsCount(void);
+
+/**
+ * Get the per-field minimum over the timing history
+ */
+VRFrameStats GetVRFrameStatsMin(void);
+
+/**
+ * Get the per-field average over the timing history
+ */
+VRFrameStats GetVRFrameStatsAvg(void);
+
+/**
+ * Get the per-field 99th percentile over the timing history
+ */
+VRFrameStats GetVRFrameStatsP99(void);
+
+/**
+ * Start a new measurement window
+ * Count, min, average and P99 only cover frames completed after this call
+ */
+void ResetVRFrameStats(void);
+
 // =============================================================================
 // Input Functions
 // =============================================================================
@@ -292,6 +480,21 @@ bool IsPlayerGrounded(float groundHeight);
 // VR Drawing Functions (Simple API)
 // =============================================================================
 
+/**
+ * Attach the following draws to a controller or the head until EndVRDrawSpace()
+ * Keep drawing with this frame's GetController()/GetHeadset() pose. Right
+ * before the eyes render, the space is located again and the draws move
+ * with it, so held objects lag the hand by less than a frame
+ * @param space VR_SPACE_LEFT_CONTROLLER, VR_SPACE_RIGHT_CONTROLLER or VR_SPACE_HEAD
+ */
+void BeginVRDrawSpace(VRDrawSpace space);
+
+/**
+ * Go back to plain world-space drawing
+ * EndVRMode() also resets the draw space
+ */
+void EndVRDrawSpace(void);
+
 /**
  * Draw a cuboid in VR space
  * @param position Center position
@@ -308,6 +511,15 @@ void DrawVRCuboid(Vector3 position, Vector3 size, Vector3 color);
  */
 void DrawVRCube(Vector3 position, float size, Color color);
 
+/**
+ * Draw a rotated cuboid in VR space
+ * @param position Center position
+ * @param size Width, height, depth
+ * @param rotation Orientation (unit quaternion)
+ * @param color RGBA color
+ */
+void DrawVRCuboidRotated(Vector3 position, Vector3 size, Quaternion rotation, Color color);
+
 /**
  * Draw a sphere in VR space
  * @param position Center position
@@ -0,0 +1,37 @@
+#!/bin/bash
+# Compare 1x/2x/4x MSAA frame cost on the same scene with the headless bench
+# Usage: scripts/bench_msaa.sh [build dir] [extra realitylib_bench options]
+#   scripts/bench_msaa.sh build-headless --scene world --size 1440x1584
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_ROOT="$(dirname "$SCRIPT_DIR")"
+BUILD_DIR="${1:-$PROJECT_ROOT/build-headless}"
+shift || true
+
+BENCH="$BUILD_DIR/headless/realitylib_bench"
+if [ ! -x "$BENCH" ]; then
+    echo "realitylib_bench not found in $BUILD_DIR/headless (build the headless tree first)" >&2
+    exit 1
+fi
+
+ARGS=("$@")
+if [ ${#ARGS[@]} -eq 0 ]; then
+    ARGS=(--scene world)
+fi
+
+printf "%-12s %-6s %-6s %10s %10s %10s %10s\n" "scene" "asked" "msaa" "eye0 avg" "gpu avg" "frame avg" "frame p99"
+for SAMPLES in 1 2 4; do
+    "$BENCH" --msaa "$SAMPLES" "${ARGS[@]}" 2>/dev/null | while read -r LINE; do
+        # One JSON object per line; pull out the fields without needing jq
+        field() { echo "$LINE" | sed -n "s/.*\"$1\":$2.*/\1/p"; }
+        SCENE=$(field scene '"\([^"]*\)"')
+        USED=$(field msaa '\([0-9]*\)')
+        EYE=$(field eye0Ms '{[^}]*"avg":\([0-9.]*\)')
+        GPU=$(field gpuMs '{[^}]*"avg":\([0-9.]*\)')
+        FRAME=$(field frameMs '{[^}]*"avg":\([0-9.]*\)')
+        P99=$(field frameMs '{[^}]*"p99":\([0-9.]*\)')
+        printf "%-12s %-6s %-6s %10s %10s %10s %10s\n" "$SCENE" "${SAMPLES}x" "${USED}x" "$EYE" "$GPU" "$FRAME" "$P99"
+    done
+done